@@ -3,7 +3,10 @@
  ************************************/
 
 #include "Metrics.hpp"
-#include <iostream>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
 /***********
  * speedup *
  ***********/
@@ -24,3 +27,133 @@ Metrics::efficiency(const double& seq,
   return speedup(seq, par) / procs;
 }
 
+
+/*************
+ * karpFlatt *
+ *************/
+
+double
+Metrics::karpFlatt(const double& seq,
+		   const double& par,
+		   const unsigned& procs) {
+  const double inverse = 1.0 / procs;
+  return (1.0 / speedup(seq, par) - inverse) / (1.0 - inverse);
+}
+
+/***********
+ * scaling *
+ ***********/
+
+Metrics::Scaling
+Metrics::scaling(const double& seq,
+		 const std::vector< unsigned >& procs,
+		 const std::vector< double >& pars) {
+
+  Scaling analysis;
+  analysis.procs = procs;
+  analysis.amdahl = 0;
+  analysis.gustafson = 0;
+  analysis.overhead = 0;
+  analysis.optimal = 1;
+  analysis.bounded = false;
+
+  // Accélérations, fractions de Karp-Flatt et sommes des moindres carrés
+  // d'Amdahl (en x = 1 / p) et de Gustafson (en p - 1).
+  double amdahlNum = 0, amdahlDen = 0, gustafsonNum = 0, gustafsonDen = 0;
+  for (size_t i = 0; i != procs.size(); i ++) {
+    const double p = procs[i];
+    const double s = speedup(seq, pars[i]);
+    analysis.speedups.push_back(s);
+    analysis.karpFlatt.push_back(procs[i] > 1 ?
+				 karpFlatt(seq, pars[i], procs[i]) : 0);
+    if (procs[i] > 1) {
+      const double x = 1.0 / p;
+      amdahlNum += (1 - x) * (1 / s - x);
+      amdahlDen += (1 - x) * (1 - x);
+      gustafsonNum += (p - 1) * (p - s);
+      gustafsonDen += (p - 1) * (p - 1);
+    }
+    analysis.optimal = std::max(analysis.optimal, procs[i]);
+  }
+  if (amdahlDen > 0) {
+    analysis.amdahl = amdahlNum / amdahlDen;
+    analysis.gustafson = gustafsonNum / gustafsonDen;
+  }
+
+  // Équations normales du modèle 1 / speedup = a + b / p + c p.
+  double m[3][4] = { { 0 } };
+  for (size_t i = 0; i != procs.size(); i ++) {
+    const double p = procs[i];
+    const double phi[3] = { 1, 1 / p, p };
+    const double y = pars[i] / seq;
+    for (int r = 0; r != 3; r ++) {
+      for (int c = 0; c != 3; c ++) {
+	m[r][c] += phi[r] * phi[c];
+      }
+      m[r][3] += phi[r] * y;
+    }
+  }
+
+  // Élimination de Gauss avec pivot partiel ; un système singulier (moins
+  // de trois nombres de processeurs distincts) laisse le modèle sans
+  // optimum.
+  for (int k = 0; k != 3; k ++) {
+    int pivot = k;
+    for (int r = k + 1; r != 3; r ++) {
+      if (std::fabs(m[r][k]) > std::fabs(m[pivot][k])) {
+	pivot = r;
+      }
+    }
+    if (std::fabs(m[pivot][k]) < 1e-12 * std::fabs(m[0][0])) {
+      return analysis;
+    }
+    std::swap(m[k], m[pivot]);
+    for (int r = 0; r != 3; r ++) {
+      if (r != k) {
+	const double factor = m[r][k] / m[k][k];
+	for (int c = k; c != 4; c ++) {
+	  m[r][c] -= factor * m[k][c];
+	}
+      }
+    }
+  }
+  const double b = m[1][3] / m[1][1];
+  const double c = m[2][3] / m[2][2];
+  analysis.overhead = c;
+  if (b > 0 && c > 0) {
+    const long optimal = std::lround(std::sqrt(b / c));
+    analysis.optimal = static_cast< unsigned >(std::max(1L, optimal));
+    analysis.bounded = true;
+  }
+  return analysis;
+
+}
+
+/**********
+ * report *
+ **********/
+
+void
+Metrics::report(std::ostream& stream, const Scaling& analysis) {
+  stream << "--[ Scaling: begin ]--" << std::endl;
+  stream << "\tThread(s)\tSpeedup\t\tEfficiency\tKarp-Flatt" << std::endl;
+  for (size_t i = 0; i != analysis.procs.size(); i ++) {
+    stream << '\t' << analysis.procs[i]
+	   << "\t\t" << analysis.speedups[i]
+	   << "\t\t" << analysis.speedups[i] / analysis.procs[i]
+	   << "\t\t";
+    if (analysis.procs[i] > 1) {
+      stream << analysis.karpFlatt[i];
+    }
+    else {
+      stream << '-';
+    }
+    stream << std::endl;
+  }
+  stream << "\tAmdahl (f):\t\t" << analysis.amdahl << std::endl;
+  stream << "\tGustafson (alpha):\t" << analysis.gustafson << std::endl;
+  stream << "\tSurcoût (c):\t\t" << analysis.overhead << std::endl;
+  stream << "\tThreads optimal:\t"
+	 << (analysis.bounded ? "" : ">= ") << analysis.optimal << std::endl;
+  stream << "--[ Scaling: end ]--" << std::endl;
+}
@@ -1,6 +1,9 @@
 #ifndef Metrics_hpp
 #define Metrics_hpp
 
+#include <vector>
+#include <ostream>
+
 /**
  * @class Metrics Metrics.hpp
  *
@@ -35,6 +38,84 @@ public:
 			   const double& par,
 			   const unsigned& procs);
 
+  /**
+   * Calcule la fraction séquentielle expérimentale de Karp et Flatt :
+   * e = (1 / speedup - 1 / procs) / (1 - 1 / procs). Constante, elle mesure
+   * la partie séquentielle du programme ; croissante avec procs, elle trahit
+   * un surcoût de parallélisation (synchronisations, bande passante).
+   *
+   * @param[in] seq - la durée d'exécution du meilleur algorithme séquentiel 
+   *   permettant de résoudre le problème.
+   * @param[in] par - la durée d'exécution de l'algorithme parallèle.
+   * @param[in] procs - le nombre de processeurs utilisés, au moins 2.
+   * @return la fraction séquentielle expérimentale.
+   */
+  static double karpFlatt(const double& seq,
+			  const double& par,
+			  const unsigned& procs);
+
+  /**
+   * Analyse d'un balayage du nombre de processeurs.
+   */
+  struct Scaling {
+
+    /** Les nombres de processeurs mesurés. */
+    std::vector< unsigned > procs;
+
+    /** Les facteurs d'accélération correspondants. */
+    std::vector< double > speedups;
+
+    /** Les fractions de Karp-Flatt correspondantes (0 pour un processeur). */
+    std::vector< double > karpFlatt;
+
+    /** La fraction séquentielle f de la loi d'Amdahl ajustée. */
+    double amdahl;
+
+    /** La fraction séquentielle alpha de la loi de Gustafson ajustée. */
+    double gustafson;
+
+    /** Le surcoût par processeur c du modèle a + b / p + c p. */
+    double overhead;
+
+    /** Le nombre de processeurs optimal prédit par ce modèle. */
+    unsigned optimal;
+
+    /** Faux si le modèle ne prédit aucun optimum (c <= 0) : optimal est
+	alors le plus grand nombre de processeurs mesuré. */
+    bool bounded;
+
+  };
+
+  /**
+   * Ajuste les lois d'Amdahl et de Gustafson (moindres carrés) sur un
+   * balayage du nombre de processeurs et prédit le nombre de processeurs
+   * optimal.
+   *
+   * @param[in] seq - la durée d'exécution du meilleur algorithme séquentiel 
+   *   permettant de résoudre le problème.
+   * @param[in] procs - les nombres de processeurs mesurés.
+   * @param[in] pars - les durées d'exécution parallèles correspondantes.
+   * @return l'analyse du balayage.
+   *
+   * @note Amdahl : 1 / speedup = f + (1 - f) / p, ajustée sur f seul.
+   *   Gustafson : speedup = p - alpha (p - 1), ajustée sur alpha seul ; elle
+   *   n'a de sens que pour des mesures à taille par processeur constante
+   *   (weak scaling). Le nombre optimal est le minimum de
+   *   1 / speedup = a + b / p + c p (ajusté sur a, b et c), soit
+   *   sqrt(b / c) lorsque b et c sont positifs.
+   */
+  static Scaling scaling(const double& seq,
+			 const std::vector< unsigned >& procs,
+			 const std::vector< double >& pars);
+
+  /**
+   * Affiche l'analyse d'un balayage du nombre de processeurs.
+   *
+   * @param[in,out] stream - le flot de sortie.
+   * @param[in] analysis - l'analyse à afficher.
+   */
+  static void report(std::ostream& stream, const Scaling& analysis);
+
 }; // Metrics
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <iterator>
 #include <tbb/tbb.h>
 #include <iostream>
 #include <sstream>
@@ -20,6 +21,9 @@ namespace merging {
    *   récursion est interrompue lorsque la somme des tailles des deux 
    *   sous-conteneurs à fusionner passe sous une certaine tolérance. La fusion 
    *   est alors effectuée via l'algorithme merge de la bibliothèque standard.
+   * @note applyLimited borne la profondeur de la récursion selon le nombre
+   *   de threads (quelques tâches par thread) au lieu de la seule tolérance,
+   *   et réutilise un unique groupe de tâches.
    */
   class ParallelRecursiveMerge {
   public:
@@ -123,6 +127,69 @@ namespace merging {
       
     } // apply
 
+    /**
+     * Forme de l'algorithme dont le nombre de tâches est limité par le
+     * parallélisme disponible et non plus seulement par la tolérance : au
+     * lieu d'un tbb::parallel_invoke à chaque niveau jusqu'à la tolérance,
+     * la récursion s'arrête après ceil(log2(P * tasksPerThread)) niveaux, P
+     * étant le nombre de threads de l'arène courante. Chaque niveau coupe le
+     * conteneur cible en son milieu (recherche dichotomique sur la diagonale
+     * du chemin de fusion), lance la première moitié comme une tâche d'un
+     * unique tbb::task_group et traite la seconde sur place ; chaque tâche
+     * est ensuite fusionnée par l'algorithme merge de la bibliothèque
+     * standard.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la récursion s'arrête de toute façon ;
+     * @param[in] tasksPerThread - le nombre de tâches visé par thread.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyLimited(const InputRandomAccessIterator1& first1,
+		 const InputRandomAccessIterator1& last1,
+		 const InputRandomAccessIterator2& first2,
+		 const InputRandomAccessIterator2& last2,
+		 const OutputRandomAccessIterator& result,
+		 const Compare& comp,
+		 const size_t& cutoff,
+		 const size_t& tasksPerThread = 4) {
+
+      // Profondeur : plus petit d tel que 2^d >= P * tasksPerThread.
+      const size_t tasks =
+	static_cast< size_t >(tbb::this_task_arena::max_concurrency()) *
+	std::max< size_t >(tasksPerThread, 1);
+      unsigned depth = 0;
+      while ((size_t(1) << depth) < tasks) {
+	depth ++;
+      }
+
+      tbb::task_group groupeTache;
+      strategyLimited(first1, last1, first2, last2, result, comp,
+		      std::max< size_t >(cutoff, 2), depth, groupeTache);
+      groupeTache.wait();
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // applyLimited
+
   protected:
 
 
@@ -162,6 +229,80 @@ namespace merging {
 
     } // strategyB
 
+    /**
+     * Récursion à profondeur limitée (voir applyLimited).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la récursion s'arrête (au moins 2) ;
+     * @param[in] depth - le nombre de niveaux de récursion restants ;
+     * @param[in,out] group - le groupe de tâches, unique pour toute la fusion.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void strategyLimited(InputRandomAccessIterator1 first1,
+				const InputRandomAccessIterator1& last1,
+				InputRandomAccessIterator2 first2,
+				const InputRandomAccessIterator2& last2,
+				OutputRandomAccessIterator result,
+				const Compare& comp,
+				const size_t& cutoff,
+				unsigned depth,
+				tbb::task_group& group) {
+      typedef typename std::iterator_traits< InputRandomAccessIterator1 >
+	::difference_type InputSize1;
+
+      for (; depth != 0; depth --) {
+	const auto size1 = last1 - first1;
+	const auto size2 = last2 - first2;
+	if (static_cast< size_t >(size1 + size2) < cutoff) {
+	  break;
+	}
+
+	// Diagonale du milieu du conteneur cible : j éléments du premier
+	// sous-conteneur et half - j du second la précèdent, j étant le plus
+	// petit rang tel que first2[half - j - 1] < first1[j].
+	const auto half = (size1 + size2) / 2;
+	InputSize1 low = half > size2 ? half - size2 : 0;
+	InputSize1 high = std::min< InputSize1 >(half, size1);
+	while (low < high) {
+	  const InputSize1 middle = low + (high - low) / 2;
+	  if (comp(first2[half - middle - 1], first1[middle])) {
+	    high = middle;
+	  }
+	  else {
+	    low = middle + 1;
+	  }
+	}
+	const InputRandomAccessIterator1 middle1 = first1 + low;
+	const InputRandomAccessIterator2 middle2 = first2 + (half - low);
+
+	// Première moitié confiée au groupe, seconde moitié traitée par
+	// l'itération suivante.
+	group.run([=, &group]() {
+	    strategyLimited(first1, middle1, first2, middle2, result, comp,
+			    cutoff, depth - 1, group);
+	  });
+	first1 = middle1;
+	first2 = middle2;
+	result += half;
+      }
+      std::merge(first1, last1, first2, last2, result, comp);
+    } // strategyLimited
+
     /**
      * Implementation de tbb_invoke sur un merge de maniere recursive (strategyB)
      *
@@ -0,0 +1,208 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "CutoffCache.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * Enregistrement de Bytes octets trié selon une clé entière : il permet de
+ * calibrer des tailles d'éléments supérieures à celles des types de base.
+ */
+template< size_t Bytes >
+struct Record {
+  std::int64_t key;                             /** La clé de tri. */
+  char payload[Bytes - sizeof(std::int64_t)];   /** La charge utile. */
+};
+
+/**
+ * Relation d'ordre sur les clés.
+ */
+template< typename Type >
+struct KeyLess {
+  bool operator()(const Type& a, const Type& b) const {
+    return a < b;
+  }
+};
+
+template< size_t Bytes >
+struct KeyLess< Record< Bytes > > {
+  bool operator()(const Record< Bytes >& a, const Record< Bytes >& b) const {
+    return a.key < b.key;
+  }
+};
+
+/**
+ * Affecte une clé à un élément.
+ */
+template< typename Type >
+void setKey(Type& x, const std::int64_t& key) {
+  x = static_cast< Type >(key);
+}
+
+template< size_t Bytes >
+void setKey(Record< Bytes >& x, const std::int64_t& key) {
+  x.key = key;
+}
+
+/**
+ * Calibre la tolérance de ParallelRecursiveMerge pour un type d'éléments :
+ * pour chaque nombre de threads, toutes les tolérances candidates sont
+ * chronométrées dans une task_arena limitée à ce nombre de threads et la
+ * meilleure est enregistrée dans le cache.
+ *
+ * @param[in] name - le nom du type des éléments ;
+ * @param[in] size - le nombre d'éléments de chaque conteneur à fusionner ;
+ * @param[in] iters - le nombre de fusions chronométrées par mesure ;
+ * @param[in] threads - les nombres de threads à calibrer ;
+ * @param[in] cutoffs - les tolérances candidates.
+ */
+template< typename Type >
+void
+calibrate(const std::string& name,
+	  const size_t& size,
+	  const size_t& iters,
+	  const std::vector< int >& threads,
+	  const std::vector< size_t >& cutoffs) {
+
+  const KeyLess< Type > comp;
+
+  // Deux tableaux triés de clés aléatoires.
+  std::mt19937_64 generator(19);
+  std::vector< Type > lhs(size), rhs(size), result(2 * size);
+  for (auto& x : lhs) {
+    setKey(x, generator() % (4 * size));
+  }
+  for (auto& x : rhs) {
+    setKey(x, generator() % (4 * size));
+  }
+  std::sort(lhs.begin(), lhs.end(), comp);
+  std::sort(rhs.begin(), rhs.end(), comp);
+
+  std::cout << "--[ Calibration<" << name << ">: begin ]--" << std::endl;
+  for (const int nb : threads) {
+    tbb::task_arena arena(nb);
+    size_t best = cutoffs.front();
+    double bestTime = -1;
+    arena.execute([&]() {
+      for (const size_t cutoff : cutoffs) {
+
+	// Fusion de chauffe non chronométrée.
+	merging::ParallelRecursiveMerge::apply(lhs.begin(), lhs.end(),
+					       rhs.begin(), rhs.end(),
+					       result.begin(),
+					       comp,
+					       cutoff);
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i != iters; i ++) {
+	  merging::ParallelRecursiveMerge::apply(lhs.begin(), lhs.end(),
+						 rhs.begin(), rhs.end(),
+						 result.begin(),
+						 comp,
+						 cutoff);
+	}
+	const auto stop = std::chrono::steady_clock::now();
+	const double time =
+	  std::chrono::duration< double, std::milli >(stop - start).count();
+	if (bestTime < 0 || time < bestTime) {
+	  bestTime = time;
+	  best = cutoff;
+	}
+      }
+    });
+    merging::CutoffCache::record(sizeof(Type), nb, best);
+    std::cout << "\tThread(s):\t" << nb
+	      << "\tCutoff:\t" << best
+	      << "\tDurée:\t" << bestTime / iters << " msec." << std::endl;
+  }
+  std::cout << "--[ Calibration: end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque conteneur à fusionner.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof() || size == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Nombres de threads calibrés : les puissances de deux jusqu'au nombre de
+  // cores logiques, celui-ci compris.
+#ifdef __TBB_info_H
+  const int concurrency = tbb::info::default_concurrency();
+#else
+  const int concurrency = tbb::this_task_arena::max_concurrency();
+#endif
+  std::vector< int > threads;
+  for (int nb = 1; nb < concurrency; nb *= 2) {
+    threads.push_back(nb);
+  }
+  threads.push_back(concurrency);
+
+  // Tolérances candidates : les puissances de deux de 256 à 256K.
+  std::vector< size_t > cutoffs;
+  for (size_t cutoff = 256; cutoff <= 256 * 1024; cutoff *= 2) {
+    cutoffs.push_back(cutoff);
+  }
+
+  calibrate< std::int32_t >("int32", size, iters, threads, cutoffs);
+  calibrate< std::int64_t >("int64", size, iters, threads, cutoffs);
+  calibrate< Record< 16 > >("16 octets", size, iters, threads, cutoffs);
+  calibrate< Record< 32 > >("32 octets", size, iters, threads, cutoffs);
+  calibrate< Record< 64 > >("64 octets", size, iters, threads, cutoffs);
+
+  // Écriture du cache.
+  if (! merging::CutoffCache::save()) {
+    std::cerr << "Écriture impossible : " << merging::CutoffCache::path()
+	      << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Cache:\t" << merging::CutoffCache::path() << std::endl;
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
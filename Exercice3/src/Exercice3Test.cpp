@@ -1,5 +1,6 @@
 #include "ParallelRecursiveMerge.hpp"
 #include "Metrics.hpp"
+#include <tbb/task_arena.h>
 #include <vector>
 #include <numeric>
 #include <iostream>
@@ -69,12 +70,12 @@ main(int argc, char* argv[]) {
                  comp);
     }
     stop = std::chrono::steady_clock::now();
-    const int seq = 
-    std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count(); 
+    const double seq = 
+    std::chrono::duration< double, std::milli >(stop - start).count(); 
 
   // Affichage des performances de la version séquentielle.
   std::cout << "--[ merge: begin ]--" << std::endl;
-  std::cout << "\tDurée:\t\t" << seq << " sec." << std::endl;
+  std::cout << "\tDurée:\t\t" << seq << " msec." << std::endl;
   std::cout << "\tVerdict:\t\t"
   	    << std::boolalpha 
   	    << std::is_sorted(result.begin(), result.end(), comp)
@@ -96,25 +97,35 @@ main(int argc, char* argv[]) {
        cutoff < result.size();
        cutoff += 1024) {
 
+    // Balayage du nombre de threads : chaque mesure s'exécute dans une arène
+    // limitée à nb threads.
+    std::vector< unsigned > procs;
+    std::vector< double > pars;
     for (int nb = 1; nb <= threads; nb ++) {
+    tbb::task_arena arena(nb);
     start = std::chrono::steady_clock::now();
-    for (size_t i = 0; i != iters; i ++) {
+    arena.execute([&]() {
+      for (size_t i = 0; i != iters; i ++) {
         merging::ParallelRecursiveMerge::apply(lhs.begin(), 
                                                lhs.end(),
                                                rhs.begin(), 
                                                rhs.end(),
                                                result.begin(),
                                                comp,
-                                               nb);
-    }
+                                               cutoff);
+      }
+    });
     stop = std::chrono::steady_clock::now();
-    const int par = 
-    std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count();    
+    const double par = 
+    std::chrono::duration< double, std::milli >(stop - start).count();    
+    procs.push_back(nb);
+    pars.push_back(par);
 
     // Affichage des résultats de la version parallèle avec, en plus, le calcul
     // des facteurs d'accélération et d'efficacité. Une accélération sur-linéaire
     // indique une meilleure utilisation des caches L2 (partagé) et L1 (privé).  
     std::cout << "--[ ParallelStableMerge: begin ]--" << std::endl;
+    std::cout << "\tCutoff:\t\t" << cutoff << std::endl;
     std::cout << "\tThread(s):\t" << nb << std::endl;
     std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
     std::cout << "\tVerdict:\t\t"
@@ -131,6 +142,9 @@ main(int argc, char* argv[]) {
     std::cout << std::endl;
     }
 
+    // Lois d'échelle ajustées sur le balayage et nombre de threads optimal.
+    Metrics::report(std::cout, Metrics::scaling(seq, procs, pars));
+    std::cout << std::endl;
     
     }
   // Tout s'est bien passé.
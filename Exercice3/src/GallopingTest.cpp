@@ -0,0 +1,161 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <numeric>
+#include <random>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Remplit deux conteneurs triés de size éléments chacun : les valeurs
+ * consécutives sont réparties entre les deux conteneurs par blocs dont la
+ * taille suit une loi géométrique de moyenne block. Une moyenne de 1 produit
+ * des entrées entrelacées ; à partir de size, les entrées sont disjointes.
+ *
+ * @param[out] lhs - le premier conteneur ;
+ * @param[out] rhs - le second conteneur ;
+ * @param[in] size - le nombre d'éléments de chaque conteneur ;
+ * @param[in] block - la taille moyenne des blocs.
+ */
+void
+fill(std::vector< Type >& lhs, std::vector< Type >& rhs,
+     const size_t& size, const double& block) {
+  std::mt19937 generator(19);
+  std::geometric_distribution< size_t > length(1.0 / block);
+  lhs.clear();
+  rhs.clear();
+  Type value = 0;
+  bool left = true;
+  while (lhs.size() < size || rhs.size() < size) {
+    std::vector< Type >& target = (left && lhs.size() < size) ||
+      rhs.size() == size ? lhs : rhs;
+    const size_t n0 = block >= size ? size : length(generator) + 1;
+    for (size_t n = n0; n != 0 && target.size() < size; n --) {
+      target.push_back(value ++);
+    }
+    left = ! left;
+  }
+}
+
+/**
+ * Compare les noyaux MergeKernel et GallopingKernel aux feuilles de
+ * ParallelRecursiveMerge.
+ *
+ * @param[in] name - le nom de la distribution ;
+ * @param[in] block - la taille moyenne des blocs ;
+ * @param[in] iters - le nombre de répétitions.
+ */
+void
+compare(const std::string& name, const double& block, const size_t& iters) {
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+
+  // Tolérance de ParallelRecursiveMerge.
+  const size_t cutoff = 16 * 1024;
+
+  // Deux conteneurs triés et le résultat attendu de leur fusion.
+  const size_t size = 4 * 1024 * 1024;
+  std::vector< Type > lhs, rhs;
+  fill(lhs, rhs, size, block);
+  std::vector< Type > expected(2 * size), result(2 * size);
+  std::iota(expected.begin(), expected.end(), 0);
+
+  // Durée d'exécution avec le noyau par défaut.
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    merging::ParallelRecursiveMerge::apply(lhs.begin(), lhs.end(),
+					   rhs.begin(), rhs.end(),
+					   result.begin(),
+					   comp,
+					   cutoff);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  const double kernel =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+  const bool kernelOk = result == expected;
+
+  // Durée d'exécution avec le noyau adaptatif.
+  std::fill(result.begin(), result.end(), 0);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    merging::ParallelRecursiveMerge::apply< merging::GallopingKernel >(
+      lhs.begin(), lhs.end(),
+      rhs.begin(), rhs.end(),
+      result.begin(),
+      comp,
+      cutoff);
+  }
+  stop = std::chrono::steady_clock::now();
+  const double galloping =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+  const bool gallopingOk = result == expected;
+
+  // Affichage des résultats.
+  std::cout << "--[ " << name << " (blocs de " << block << "): begin ]--"
+	    << std::endl;
+  std::cout << "\tMergeKernel:\t\t" << kernel << " msec." << std::endl;
+  std::cout << "\tGallopingKernel:\t" << galloping << " msec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << (kernelOk && gallopingOk)
+	    << std::endl;
+  std::cout << "\tSpeedup:\t\t"
+	    << Metrics::speedup(kernel, galloping)
+	    << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  compare("Disjointes", 4 * 1024 * 1024, iters);
+  compare("Entrelacées", 1, iters);
+  compare("Regroupées", 1000, iters);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,193 @@
+#include "ParallelInplaceMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <atomic>
+#include <new>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Nombre d'octets alloués dynamiquement et maximum atteint depuis la dernière
+ * remise à zéro.
+ */
+static std::atomic< size_t > allocated(0);
+static std::atomic< size_t > peak(0);
+
+/**
+ * Opérateurs d'allocation globaux mesurant la mémoire allouée : la taille de
+ * chaque bloc est mémorisée dans un en-tête.
+ */
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  char* const p = static_cast< char* >(std::malloc(size + 16));
+  if (p == nullptr) {
+    return nullptr;
+  }
+  *reinterpret_cast< std::size_t* >(p) = size;
+  const size_t now = allocated.fetch_add(size) + size;
+  size_t old = peak.load();
+  while (now > old && ! peak.compare_exchange_weak(old, now)) {
+  }
+  return p + 16;
+}
+
+void* operator new(std::size_t size) {
+  void* const p = operator new(size, std::nothrow);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  if (p != nullptr) {
+    char* const q = static_cast< char* >(p) - 16;
+    allocated.fetch_sub(*reinterpret_cast< std::size_t* >(q));
+    std::free(q);
+  }
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  operator delete(p);
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations cutoff" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et de la tolérance.
+  size_t iters, cutoff;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> cutoff;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à fusionner.
+  typedef long Type;
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+
+  // Un conteneur formé de deux sous-conteneurs triés adjacents de tailles
+  // différentes et comportant de nombreux doublons.
+  const size_t size1 = 16 * 1024 * 1024, size2 = size1 + 211;
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution(0, size1 / 4);
+  std::vector< Type > data(size1 + size2);
+  for (auto& x : data) {
+    x = distribution(generator);
+  }
+  std::sort(data.begin(), data.begin() + size1, comp);
+  std::sort(data.begin() + size1, data.end(), comp);
+  std::vector< Type > expected(data), work(data.size());
+
+  // Durée d'exécution et mémoire supplémentaire de l'algorithme inplace_merge
+  // de la bibliothèque standard. La recopie de la donnée n'est pas
+  // chronométrée.
+  double seq = 0;
+  size_t seqPeak = 0;
+  for (size_t i = 0; i != iters; i ++) {
+    std::copy(data.begin(), data.end(), expected.begin());
+    const size_t base = allocated.load();
+    peak = base;
+    const auto start = std::chrono::steady_clock::now();
+    std::inplace_merge(expected.begin(), expected.begin() + size1,
+		       expected.end(),
+		       comp);
+    const auto stop = std::chrono::steady_clock::now();
+    seqPeak = std::max(seqPeak, peak.load() - base);
+    seq += std::chrono::duration< double, std::milli >(stop - start).count();
+  }
+
+  std::cout << "--[ inplace_merge: begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << seq << " msec." << std::endl;
+  std::cout << "\tMémoire:\t" << seqPeak << " octets" << std::endl;
+  std::cout << "--[ inplace_merge: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // Durée d'exécution et mémoire supplémentaire de ParallelInplaceMerge. Le
+  // résultat doit être identique à celui de inplace_merge, qui est stable.
+  double par = 0;
+  size_t parPeak = 0;
+  bool ok = true;
+  for (size_t i = 0; i != iters; i ++) {
+    std::copy(data.begin(), data.end(), work.begin());
+    const size_t base = allocated.load();
+    peak = base;
+    const auto start = std::chrono::steady_clock::now();
+    merging::ParallelInplaceMerge::apply(work.begin(), work.begin() + size1,
+					 work.end(),
+					 comp,
+					 cutoff);
+    const auto stop = std::chrono::steady_clock::now();
+    parPeak = std::max(parPeak, peak.load() - base);
+    par += std::chrono::duration< double, std::milli >(stop - start).count();
+    ok = ok && work == expected;
+  }
+
+  // Affichage des résultats de la version parallèle avec, en plus, le calcul
+  // des facteurs d'accélération et d'efficacité.
+#ifdef __TBB_info_H
+  const int threads = tbb::info::default_concurrency();
+#else
+  const int threads = tbb::this_task_arena::max_concurrency();
+#endif
+  std::cout << "--[ ParallelInplaceMerge: begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
+  std::cout << "\tMémoire:\t" << parPeak << " octets" << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << ok
+	    << std::endl;
+  std::cout << "\tSpeedup:\t"
+	    << Metrics::speedup(seq, par)
+	    << std::endl;
+  std::cout << "\tEfficiency:\t"
+	    << Metrics::efficiency(seq, par, threads)
+	    << std::endl;
+  std::cout << "--[ ParallelInplaceMerge: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,132 @@
+#include "MergeKernel.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * Compare, sur un seul cœur, l'algorithme merge de la bibliothèque standard
+ * et MergeKernel sur deux conteneurs triés de valeurs aléatoires.
+ *
+ * @param[in] name - le nom du type des éléments et de la relation d'ordre ;
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] comp - la relation d'ordre (croissante ou décroissante).
+ */
+template< typename Type, typename Compare >
+void
+compare(const std::string& name, const size_t& iters, const Compare& comp) {
+
+  // Deux tableaux triés de valeurs aléatoires de tailles différentes.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< int > distribution(-1000000, 1000000);
+  std::vector< Type > lhs(1024 * 1024), rhs(lhs.size() + 211);
+  for (auto& x : lhs) {
+    x = distribution(generator);
+  }
+  for (auto& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end(), comp);
+  std::sort(rhs.begin(), rhs.end(), comp);
+
+  // Conteneurs accueillant le résultat de la fusion.
+  std::vector< Type > expected(lhs.size() + rhs.size());
+  std::vector< Type > result(expected.size());
+
+  // Durée d'exécution de l'algorithme merge de la bibliothèque standard.
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    std::merge(lhs.begin(), lhs.end(),
+	       rhs.begin(), rhs.end(),
+	       expected.begin(),
+	       comp);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  const double seq =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  // Durée d'exécution du noyau de fusion.
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    merging::MergeKernel::apply(lhs.begin(), lhs.end(),
+				rhs.begin(), rhs.end(),
+				result.begin(),
+				comp);
+  }
+  stop = std::chrono::steady_clock::now();
+  const double kernel =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  // Affichage des résultats avec le facteur d'accélération par cœur.
+  std::cout << "--[ MergeKernel<" << name << ">: begin ]--" << std::endl;
+  std::cout << "\tmerge:\t\t" << seq << " msec." << std::endl;
+  std::cout << "\tDurée:\t\t" << kernel << " msec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << (result == expected)
+	    << std::endl;
+  std::cout << "\tSpeedup:\t"
+	    << Metrics::speedup(seq, kernel)
+	    << std::endl;
+  std::cout << "--[ MergeKernel: end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Ordre croissant puis décroissant : le réseau de fusion vectoriel
+  // inverse ses min/max selon la relation d'ordre.
+  compare< std::int32_t >("int32, <", iters, std::less< std::int32_t >());
+  compare< std::int64_t >("int64, <", iters, std::less< std::int64_t >());
+  compare< float >("float, <", iters, std::less< float >());
+  compare< double >("double, <", iters, std::less< double >());
+  compare< std::int32_t >("int32, >", iters, std::greater< std::int32_t >());
+  compare< std::int64_t >("int64, >", iters, std::greater< std::int64_t >());
+  compare< float >("float, >", iters, std::greater< float >());
+  compare< double >("double, >", iters, std::greater< double >());
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,254 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Noyau de fusion comptant les feuilles de la récursion et la taille de la
+ * plus grande, puis déléguant la fusion à MergeKernel.
+ */
+struct CountingKernel {
+
+  static std::atomic< size_t > leaves;    /** Nombre de feuilles. */
+  static std::atomic< size_t > largest;   /** Taille de la plus grande. */
+
+  /**
+   * Remet les compteurs à zéro.
+   */
+  static void reset() {
+    leaves = 0;
+    largest = 0;
+  }
+
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  static OutputRandomAccessIterator
+  apply(const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    const size_t size = (last1 - first1) + (last2 - first2);
+    leaves ++;
+    size_t current = largest;
+    while (current < size && ! largest.compare_exchange_weak(current, size)) {
+    }
+    return merging::MergeKernel::apply(first1, last1, first2, last2, result,
+				       comp);
+  }
+
+};
+
+std::atomic< size_t > CountingKernel::leaves(0);
+std::atomic< size_t > CountingKernel::largest(0);
+
+/**
+ * Synonyme du type d'une stratégie de fusion.
+ */
+typedef std::function< void(const std::vector< Type >&,
+			    const std::vector< Type >&,
+			    std::vector< Type >&) > Strategy;
+
+/**
+ * Mesures d'une stratégie sur une distribution.
+ */
+struct Measure {
+  double duration;    /** Durée totale en millisecondes. */
+  size_t leaves;      /** Nombre de feuilles d'une fusion. */
+  size_t largest;     /** Taille de la plus grande feuille. */
+  bool ok;            /** Verdict. */
+};
+
+/**
+ * Chronomètre une stratégie puis compte ses feuilles.
+ *
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] lhs - le premier conteneur ;
+ * @param[in] rhs - le second conteneur ;
+ * @param[in] expected - le résultat attendu ;
+ * @param[in] timed - la stratégie avec le noyau MergeKernel ;
+ * @param[in] counted - la même stratégie avec le noyau CountingKernel.
+ * @return les mesures.
+ */
+Measure
+measure(const size_t& iters,
+	const std::vector< Type >& lhs, const std::vector< Type >& rhs,
+	const std::vector< Type >& expected,
+	const Strategy& timed, const Strategy& counted) {
+  std::vector< Type > result(expected.size());
+  Measure m;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    timed(lhs, rhs, result);
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  m.duration = std::chrono::duration< double, std::milli >(stop - start).count();
+  m.ok = result == expected;
+  CountingKernel::reset();
+  counted(lhs, rhs, result);
+  m.leaves = CountingKernel::leaves;
+  m.largest = CountingKernel::largest;
+  m.ok = m.ok && result == expected;
+  return m;
+}
+
+/**
+ * Compare la coupe au milieu du plus long sous-conteneur (apply) à la coupe
+ * par chemin de fusion (applyMergePath) sur une distribution.
+ *
+ * @param[in] name - le nom de la distribution ;
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] lhs - le premier conteneur, trié ;
+ * @param[in] rhs - le second conteneur, trié ;
+ * @param[in] cutoff - la tolérance des deux stratégies.
+ */
+void
+compare(const std::string& name, const size_t& iters,
+	const std::vector< Type >& lhs, const std::vector< Type >& rhs,
+	const size_t& cutoff) {
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+
+  std::vector< Type > expected(lhs.size() + rhs.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	     expected.begin(), comp);
+
+  const Measure midpoint =
+    measure(iters, lhs, rhs, expected,
+	    [&](const std::vector< Type >& a, const std::vector< Type >& b,
+		std::vector< Type >& c) {
+	      merging::ParallelRecursiveMerge::apply(a.begin(), a.end(),
+						     b.begin(), b.end(),
+						     c.begin(), comp, cutoff);
+	    },
+	    [&](const std::vector< Type >& a, const std::vector< Type >& b,
+		std::vector< Type >& c) {
+	      merging::ParallelRecursiveMerge::apply< CountingKernel >(
+		a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+		cutoff);
+	    });
+  const Measure mergePath =
+    measure(iters, lhs, rhs, expected,
+	    [&](const std::vector< Type >& a, const std::vector< Type >& b,
+		std::vector< Type >& c) {
+	      merging::ParallelRecursiveMerge::applyMergePath(
+		a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+		cutoff);
+	    },
+	    [&](const std::vector< Type >& a, const std::vector< Type >& b,
+		std::vector< Type >& c) {
+	      merging::ParallelRecursiveMerge::applyMergePath< CountingKernel >(
+		a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+		cutoff);
+	    });
+
+  // Affichage des résultats.
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tTailles:\t\t" << lhs.size() << " + " << rhs.size()
+	    << std::endl;
+  std::cout << "\tMilieu:\t\t\t" << midpoint.duration << " msec.\t"
+	    << midpoint.leaves << " feuilles, max " << midpoint.largest
+	    << std::endl;
+  std::cout << "\tChemin de fusion:\t" << mergePath.duration << " msec.\t"
+	    << mergePath.leaves << " feuilles, max " << mergePath.largest
+	    << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha
+	    << (midpoint.ok && mergePath.ok) << std::endl;
+  std::cout << "\tSpeedup:\t\t"
+	    << Metrics::speedup(midpoint.duration, mergePath.duration)
+	    << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements [cutoff]"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 ou 3 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc != 3 && argc != 4) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations, du nombre d'éléments de
+  // chaque conteneur et de la tolérance (16 Ki éléments par défaut).
+  size_t iters, size, cutoff = 16 * 1024;
+  size_t* const parameters[] = { &iters, &size, &cutoff };
+  for (int a = 1; a != argc; a ++) {
+    std::istringstream entree(argv[a]);
+    entree >> *parameters[a - 1];
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::mt19937 generator(19);
+  const auto sorted = [&](const size_t& n, const Type& low, const Type& high) {
+    std::uniform_int_distribution< Type > distribution(low, high);
+    std::vector< Type > v(n);
+    for (Type& x : v) {
+      x = distribution(generator);
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+  };
+
+  // Valeurs uniformes : les deux coupes sont équilibrées.
+  compare("Uniformes", iters,
+	  sorted(size, 0, 1 << 30), sorted(size, 0, 1 << 30), cutoff);
+
+  // Doublons : 4 valeurs distinctes.
+  compare("Doublons", iters, sorted(size, 0, 3), sorted(size, 0, 3), cutoff);
+
+  // Une seule valeur : la coupe au milieu ne sépare que le plus long.
+  compare("Constantes", iters, sorted(size, 7, 7), sorted(size, 7, 7),
+	  cutoff);
+
+  // Valeurs asymétriques : le second conteneur est concentré sur le
+  // premier 128e des valeurs du premier.
+  compare("Asymétriques", iters,
+	  sorted(size, 0, 1 << 30), sorted(size, 0, 1 << 23), cutoff);
+
+  // Tailles asymétriques : le second conteneur est 64 fois plus petit.
+  compare("Tailles inégales", iters,
+	  sorted(size, 0, 1 << 30), sorted(size / 64, 0, 1 << 30), cutoff);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,189 @@
+#include "ParallelMergeSort.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Mesure la durée cumulée, en millisecondes, de plusieurs tris d'une même
+ * donnée. La recopie de la donnée avant chaque tri n'est pas chronométrée.
+ *
+ * @param[in] data - la donnée à trier ;
+ * @param[in,out] work - le conteneur de travail (de même taille que data) ;
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] sort - le tri à chronométrer.
+ * @return la durée cumulée des tris.
+ */
+template< typename Type,
+	  typename Sort >
+double
+timeSort(const std::vector< Type >& data,
+	 std::vector< Type >& work,
+	 const size_t& iters,
+	 const Sort& sort) {
+  double total = 0;
+  for (size_t i = 0; i != iters; i ++) {
+    std::copy(data.begin(), data.end(), work.begin());
+    const auto start = std::chrono::steady_clock::now();
+    sort(work);
+    const auto stop = std::chrono::steady_clock::now();
+    total += std::chrono::duration< double, std::milli >(stop - start).count();
+  }
+  return total;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations exposant_max"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et de l'exposant de la
+  // plus grande taille testée (de 10^6 à 10^exposant_max éléments).
+  size_t iters;
+  unsigned exponent;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> exponent;
+    if (! entree || ! entree.eof() || exponent < 6 || exponent > 9) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à trier.
+  typedef int Type;
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+
+  // Tolérances du tri (en dessous : std::sort) et de la fusion.
+  const size_t cutoff = 16 * 1024;
+  const size_t mergeCutoff = 16 * 1024;
+
+#ifdef __TBB_info_H
+  const int threads = tbb::info::default_concurrency();
+#else
+  const int threads = tbb::task_scheduler_init::default_num_threads();
+  tbb::task_scheduler_init init(threads);
+#endif
+
+  // Générateur pseudo-aléatoire à graine fixe pour la reproductibilité.
+  std::mt19937 generator(19);
+
+  size_t size = 1000 * 1000;
+  for (unsigned e = 6; e <= exponent; e ++, size *= 10) {
+
+    // Donnée à trier et conteneur de travail.
+    std::vector< Type > data(size), work(size);
+    std::uniform_int_distribution< Type > distribution;
+    for (auto& x : data) {
+      x = distribution(generator);
+    }
+
+    // Durée d'exécution de l'algorithme sort de la bibliothèque standard.
+    const double seq = timeSort(data, work, iters,
+				[&](std::vector< Type >& v) {
+				  std::sort(v.begin(), v.end(), comp);
+				});
+    const bool seqOk = std::is_sorted(work.begin(), work.end(), comp);
+
+    // Durée d'exécution de l'algorithme stable_sort de la bibliothèque
+    // standard.
+    const double stable = timeSort(data, work, iters,
+				   [&](std::vector< Type >& v) {
+				     std::stable_sort(v.begin(), v.end(), comp);
+				   });
+    const bool stableOk = std::is_sorted(work.begin(), work.end(), comp);
+
+    // Durée d'exécution de l'algorithme ParallelMergeSort.
+    const double par = timeSort(data, work, iters,
+				[&](std::vector< Type >& v) {
+				  merging::ParallelMergeSort::apply(v.begin(),
+								    v.end(),
+								    comp,
+								    cutoff,
+								    mergeCutoff);
+				});
+    const bool parOk = std::is_sorted(work.begin(), work.end(), comp);
+
+    // Durée d'exécution de l'algorithme ParallelMergeSort dont le tampon est
+    // puisé dans une arène à grandes pages, réutilisée d'un tri à l'autre.
+    merging::HugePageArena arena;
+    const double huge = timeSort(data, work, iters,
+				 [&](std::vector< Type >& v) {
+				   merging::ParallelMergeSort::apply(v.begin(),
+								     v.end(),
+								     comp,
+								     cutoff,
+								     mergeCutoff,
+								     arena);
+				   arena.reset();
+				 });
+    const bool hugeOk = std::is_sorted(work.begin(), work.end(), comp);
+
+    // Affichage des résultats avec, en plus, le calcul des facteurs
+    // d'accélération et d'efficacité par rapport aux deux tris standards.
+    std::cout << "--[ ParallelMergeSort: begin ]--" << std::endl;
+    std::cout << "\tTaille:\t\t10^" << e << std::endl;
+    std::cout << "\tThread(s):\t" << threads << std::endl;
+    std::cout << "\tsort:\t\t" << seq << " msec. ("
+	      << std::boolalpha << seqOk << ")" << std::endl;
+    std::cout << "\tstable_sort:\t" << stable << " msec. ("
+	      << std::boolalpha << stableOk << ")" << std::endl;
+    std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
+    std::cout << "\tVerdict:\t\t"
+	      << std::boolalpha
+	      << parOk
+	      << std::endl;
+    std::cout << "\tArène (pages "
+	      << merging::HugePageArena::name(arena.backing()) << "):\t"
+	      << huge << " msec. (" << std::boolalpha << hugeOk << ")"
+	      << std::endl;
+    std::cout << "\tSpeedup (sort):\t"
+	      << Metrics::speedup(seq, par)
+	      << std::endl;
+    std::cout << "\tSpeedup (stable_sort):\t"
+	      << Metrics::speedup(stable, par)
+	      << std::endl;
+    std::cout << "\tEfficiency:\t"
+	      << Metrics::efficiency(seq, par, threads)
+	      << std::endl;
+    std::cout << "--[ ParallelMergeSort: end ]--" << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
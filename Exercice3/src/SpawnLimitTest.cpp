@@ -0,0 +1,207 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Noyau de fusion comptant les feuilles de la récursion, puis déléguant la
+ * fusion à MergeKernel.
+ */
+struct CountingKernel {
+
+  static std::atomic< size_t > leaves;    /** Nombre de feuilles. */
+
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  static OutputRandomAccessIterator
+  apply(const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    leaves ++;
+    return merging::MergeKernel::apply(first1, last1, first2, last2, result,
+				       comp);
+  }
+
+};
+
+std::atomic< size_t > CountingKernel::leaves(0);
+
+/**
+ * Chronomètre iters exécutions d'une fonction.
+ *
+ * @param[in] iters - le nombre d'exécutions ;
+ * @param[in] f - la fonction à chronométrer.
+ * @return la durée totale en millisecondes.
+ */
+double
+timed(const size_t& iters, const std::function< void() >& f) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    f();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration< double, std::milli >(stop - start).count();
+}
+
+/**
+ * Compte les feuilles d'une fusion.
+ *
+ * @param[in] f - la fusion, avec le noyau CountingKernel.
+ * @return le nombre de feuilles.
+ */
+size_t
+count(const std::function< void() >& f) {
+  CountingKernel::leaves = 0;
+  f();
+  return CountingKernel::leaves;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque conteneur.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+
+  // Deux conteneurs triés et le résultat attendu de leur fusion.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution;
+  std::vector< Type > lhs(size), rhs(size + 211);
+  for (Type& x : lhs) {
+    x = distribution(generator);
+  }
+  for (Type& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+  std::vector< Type > expected(lhs.size() + rhs.size());
+  std::vector< Type > result(expected.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	     expected.begin(), comp);
+
+  // Référence séquentielle.
+  const double seq = timed(iters, [&]() {
+      merging::MergeKernel::apply(lhs.begin(), lhs.end(),
+				  rhs.begin(), rhs.end(),
+				  result.begin(), comp);
+    });
+  std::cout << "Thread(s):\t" << tbb::this_task_arena::max_concurrency()
+	    << std::endl;
+  std::cout << "MergeKernel:\t" << seq << " msec." << std::endl;
+  std::cout << std::endl;
+
+  // Balayage de la tolérance. apply lance deux tâches et construit un
+  // tbb::task_group à chaque coupe (feuilles - 1 coupes) ; applyLimited
+  // lance une tâche par coupe dans un unique groupe.
+  for (size_t cutoff = 1024; ; cutoff *= 4) {
+    std::fill(result.begin(), result.end(), 0);
+    const double tasking = timed(iters, [&]() {
+	merging::ParallelRecursiveMerge::apply(lhs.begin(), lhs.end(),
+					       rhs.begin(), rhs.end(),
+					       result.begin(), comp, cutoff);
+      });
+    const bool taskingOk = result == expected;
+    const size_t taskingLeaves = count([&]() {
+	merging::ParallelRecursiveMerge::apply< CountingKernel >(
+	  lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), result.begin(),
+	  comp, cutoff);
+      });
+
+    std::fill(result.begin(), result.end(), 0);
+    const double limited = timed(iters, [&]() {
+	merging::ParallelRecursiveMerge::applyLimited(lhs.begin(), lhs.end(),
+						      rhs.begin(), rhs.end(),
+						      result.begin(), comp,
+						      cutoff);
+      });
+    const bool limitedOk = result == expected;
+    const size_t limitedLeaves = count([&]() {
+	merging::ParallelRecursiveMerge::applyLimited< CountingKernel >(
+	  lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), result.begin(),
+	  comp, cutoff);
+      });
+
+    std::cout << "--[ Cutoff " << cutoff << ": begin ]--" << std::endl;
+    std::cout << "\tapply:\t\t" << tasking << " msec.\t"
+	      << 2 * (taskingLeaves - 1) << " tâches, "
+	      << taskingLeaves - 1 << " groupes\t"
+	      << std::boolalpha << taskingOk << std::endl;
+    std::cout << "\tapplyLimited:\t" << limited << " msec.\t"
+	      << limitedLeaves - 1 << " tâches, 1 groupe\t"
+	      << std::boolalpha << limitedOk << std::endl;
+    std::cout << "\tSpeedup (apply):\t" << Metrics::speedup(seq, tasking)
+	      << std::endl;
+    std::cout << "\tSpeedup (limitée):\t" << Metrics::speedup(seq, limited)
+	      << std::endl;
+    std::cout << "--[ Cutoff " << cutoff << ": end ]--" << std::endl;
+    std::cout << std::endl;
+
+    // Dernière tolérance : une seule feuille pour apply.
+    if (cutoff > expected.size()) {
+      break;
+    }
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
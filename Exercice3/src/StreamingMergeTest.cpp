@@ -0,0 +1,330 @@
+#include "StreamingMerge.hpp"
+#include "Metrics.hpp"
+#include <tbb/task_arena.h>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <string>
+#include <thread>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Synonyme du type de l'horloge.
+ */
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * Produit un flot trié par blocs : les valeurs values, en blocs de chunk
+ * éléments séparés de delay microsecondes.
+ *
+ * @param[in] values - les valeurs triées du flot ;
+ * @param[in] chunk - le nombre d'éléments d'un bloc ;
+ * @param[in] delay - l'intervalle entre deux blocs ;
+ * @param[in] emit - invoqué sur chaque bloc (std::vector< Type >&&).
+ */
+template< typename Emit >
+void
+produce(const std::vector< Type >& values, const size_t& chunk,
+	const std::chrono::microseconds& delay, const Emit& emit) {
+  for (size_t i = 0; i < values.size(); i += chunk) {
+    std::this_thread::sleep_for(delay);
+    emit(std::vector< Type >(values.begin() + i,
+			     values.begin() +
+			     std::min(i + chunk, values.size())));
+  }
+}
+
+/**
+ * Fusionne en flot deux flots produits chacun par un thread.
+ *
+ * @param[in] streams - les valeurs triées des deux flots ;
+ * @param[in] chunks - la taille des blocs de chaque flot ;
+ * @param[in] delays - l'intervalle entre deux blocs de chaque flot ;
+ * @param[in] capacity - la capacité des files ;
+ * @param[in] cutoff - la tolérance des fusions de blocs.
+ * @return le résultat de la fusion.
+ */
+std::vector< Type >
+stream(const std::vector< Type > (&streams)[2], const size_t (&chunks)[2],
+       const std::chrono::microseconds (&delays)[2],
+       const size_t& capacity, const size_t& cutoff) {
+  merging::StreamingMerge< Type > merger(capacity);
+  std::vector< Type > result;
+  std::vector< std::thread > producers;
+  for (size_t side = 0; side != 2; side ++) {
+    producers.emplace_back([&, side]() {
+	produce(streams[side], chunks[side], delays[side],
+		[&](std::vector< Type >&& block) {
+		  merger.push(side, std::move(block));
+		});
+	merger.close(side);
+      });
+  }
+  merger.run([&](const std::vector< Type >& block) {
+      result.insert(result.end(), block.begin(), block.end());
+    },
+    2 * tbb::this_task_arena::max_concurrency(),
+    cutoff);
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  return result;
+}
+
+/**
+ * Affiche la durée totale et les quantiles des latences.
+ *
+ * @param[in] name - le nom de la version mesurée ;
+ * @param[in] duration - la durée totale ;
+ * @param[in,out] latencies - les latences (triées en sortie) ;
+ * @param[in] ok - le verdict.
+ */
+void
+report(const std::string& name, const double& duration,
+       std::vector< double >& latencies, const bool& ok) {
+  std::sort(latencies.begin(), latencies.end());
+  const auto quantile = [&](const double& q) {
+    return latencies.empty() ? 0.0 :
+      latencies[static_cast< size_t >(q * (latencies.size() - 1))];
+  };
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << duration << " msec." << std::endl;
+  std::cout << "\tBlocs:\t\t" << latencies.size() << std::endl;
+  std::cout << "\tLatence p50:\t" << quantile(0.50) << " msec." << std::endl;
+  std::cout << "\tLatence p95:\t" << quantile(0.95) << " msec." << std::endl;
+  std::cout << "\tLatence p99:\t" << quantile(0.99) << " msec." << std::endl;
+  std::cout << "\tLatence max:\t" << quantile(1.0) << " msec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << ok << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Retourne la fusion de référence de deux flots.
+ *
+ * @param[in] streams - les valeurs triées des deux flots.
+ * @return leur fusion par l'algorithme merge de la bibliothèque standard.
+ */
+std::vector< Type >
+reference(const std::vector< Type > (&streams)[2]) {
+  std::vector< Type > expected(streams[0].size() + streams[1].size());
+  std::merge(streams[0].begin(), streams[0].end(),
+	     streams[1].begin(), streams[1].end(),
+	     expected.begin());
+  return expected;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0]
+	      << " nb_elements_par_flot taille_bloc [capacite [delai_us]]"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 à 4 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc < 3 || argc > 5) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction des paramètres : nombre d'éléments de chaque
+  // flot, taille d'un bloc, capacité des files (8 blocs par défaut) et
+  // intervalle entre deux blocs d'un producteur (100 µs par défaut).
+  size_t size, chunk, capacity = 8, delay = 100;
+  size_t* const parameters[] = { &size, &chunk, &capacity, &delay };
+  for (int a = 1; a < argc; a ++) {
+    std::istringstream entree(argv[a]);
+    entree >> *parameters[a - 1];
+    if (! entree || ! entree.eof() || (a == 2 && chunk == 0)) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  const std::chrono::microseconds interval(delay);
+
+  // Les blocs du flot B sont plus grands de moitié : les frontières des
+  // deux flots ne coïncident pas.
+  const size_t chunks[2] = { chunk, chunk + chunk / 2 };
+  const size_t cutoff =
+    merging::CutoffCache::lookup(sizeof(Type),
+				 tbb::this_task_arena::max_concurrency());
+
+  // Flots mesurés : le flot side (0 ou 1) contient les valeurs 2 * i + side,
+  // pour i de 0 à size - 1.
+  std::vector< Type > values[2];
+  for (size_t side = 0; side != 2; side ++) {
+    values[side].resize(size);
+    for (size_t i = 0; i != size; i ++) {
+      values[side][i] = static_cast< Type >(2 * i + side);
+    }
+  }
+  const std::vector< Type > expected = reference(values);
+
+  // Fusion par lot : attendre la fin des deux flots puis les fusionner.
+  double batch;
+  {
+    std::vector< Type > streams[2];
+    std::vector< Clock::time_point > arrivals[2];
+    const auto start = Clock::now();
+    std::vector< std::thread > producers;
+    for (size_t side = 0; side != 2; side ++) {
+      producers.emplace_back([&, side]() {
+	  produce(values[side], chunks[side], interval,
+		  [&](std::vector< Type >&& block) {
+		    streams[side].insert(streams[side].end(),
+					 block.begin(), block.end());
+		    arrivals[side].push_back(Clock::now());
+		  });
+	});
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    std::vector< Type > result(streams[0].size() + streams[1].size());
+    merging::ParallelRecursiveMerge::apply(streams[0].begin(),
+					   streams[0].end(),
+					   streams[1].begin(),
+					   streams[1].end(),
+					   result.begin(),
+					   std::less< const Type& >(),
+					   cutoff);
+    const auto stop = Clock::now();
+    batch = std::chrono::duration< double, std::milli >(stop - start).count();
+
+    // Latence de chaque bloc reçu : il n'est écrit qu'à la fin.
+    std::vector< double > latencies;
+    for (const auto& side : arrivals) {
+      for (const auto& arrival : side) {
+	latencies.push_back(
+	  std::chrono::duration< double, std::milli >(stop - arrival).count());
+      }
+    }
+    report("Fusion par lot", batch, latencies, result == expected);
+  }
+
+  // Fusion en flot : les blocs sûrs sont fusionnés et écrits au fil de
+  // l'arrivée des blocs.
+  {
+    merging::StreamingMerge< Type > merger(capacity);
+    std::vector< Type > result;
+    result.reserve(2 * size);
+    const auto start = Clock::now();
+    std::vector< std::thread > producers;
+    for (size_t side = 0; side != 2; side ++) {
+      producers.emplace_back([&, side]() {
+	  produce(values[side], chunks[side], interval,
+		  [&](std::vector< Type >&& block) {
+		    merger.push(side, std::move(block));
+		  });
+	  merger.close(side);
+	});
+    }
+    auto statistics =
+      merger.run([&](const std::vector< Type >& block) {
+	  result.insert(result.end(), block.begin(), block.end());
+	},
+	2 * tbb::this_task_arena::max_concurrency(),
+	cutoff);
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    const auto stop = Clock::now();
+    const double streaming =
+      std::chrono::duration< double, std::milli >(stop - start).count();
+    report("Fusion en flot", streaming, statistics.latencies,
+	   result == expected);
+    std::cout << "Speedup (durée totale): "
+	      << Metrics::speedup(batch, streaming) << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Vérification de la fusion en flot sur des flots moins réguliers que les
+  // flots mesurés : chaque cas met à l'épreuve le calcul du préfixe sûr.
+  {
+    std::mt19937 generator(19);
+    const auto sorted = [&](const size_t& n, const Type& low,
+			    const Type& high) {
+      std::uniform_int_distribution< Type > distribution(low, high);
+      std::vector< Type > v(n);
+      for (Type& x : v) {
+	x = distribution(generator);
+      }
+      std::sort(v.begin(), v.end());
+      return v;
+    };
+    const std::chrono::microseconds none(0);
+    const auto verify = [&](const std::string& name,
+			    const std::vector< Type > (&streams)[2],
+			    const std::chrono::microseconds (&delays)[2]) {
+      const bool ok =
+	stream(streams, chunks, delays, capacity, cutoff) ==
+	reference(streams);
+      std::cout << "\t" << name << (name.size() < 15 ? ":\t\t" : ":\t")
+		<< std::boolalpha << ok << std::endl;
+    };
+    std::cout << "--[ Vérification: begin ]--" << std::endl;
+
+    // Nombreux doublons, y compris entre les deux flots.
+    {
+      const std::vector< Type > streams[2] = { sorted(size, 0, 3),
+						sorted(size, 0, 3) };
+      verify("Doublons", streams, { interval, interval });
+    }
+
+    // Têtes égales : deux flots identiques.
+    {
+      const std::vector< Type > v = sorted(size, 0, 1 << 10);
+      const std::vector< Type > streams[2] = { v, v };
+      verify("Têtes égales", streams, { interval, interval });
+    }
+
+    // Plages décalées : le flot B est concentré sur le début du flot A,
+    // puis les deux flots sont disjoints.
+    {
+      const std::vector< Type > skewed[2] = { sorted(size, 0, 1 << 30),
+					      sorted(size, 0, 1 << 20) };
+      verify("Plages décalées", skewed, { interval, none });
+      const std::vector< Type > disjoint[2] = { sorted(size, 1 << 20, 1 << 30),
+						sorted(size, 0, 1 << 20) };
+      verify("Plages disjointes", disjoint, { interval, interval });
+    }
+
+    // Fermeture précoce : le flot A, court, se ferme bien avant le flot B,
+    // puis un flot vide.
+    {
+      const std::vector< Type > early[2] = { sorted(size / 16, 0, 1 << 20),
+					     sorted(size, 0, 1 << 20) };
+      verify("Fermeture précoce", early, { none, interval });
+      const std::vector< Type > empty[2] = { std::vector< Type >(),
+					     sorted(size, 0, 1 << 20) };
+      verify("Flot vide", empty, { none, interval });
+    }
+
+    std::cout << "--[ Vérification: end ]--" << std::endl;
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,188 @@
+#ifndef CutoffCache_hpp
+#define CutoffCache_hpp
+
+#include <map>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace merging {
+
+  /**
+   * @class CutoffCache CutoffCache.hpp
+   *
+   * Tolérances (cutoff) de ParallelRecursiveMerge calibrées sur la machine
+   * courante, indexées par la taille des éléments (en octets) et le nombre de
+   * threads.
+   *
+   * @note Le fichier cache est un fichier texte dont chaque ligne contient
+   *   « taille_element threads cutoff » ; les lignes commençant par # sont
+   *   ignorées. Son chemin est donné par la variable d'environnement
+   *   PARA_CUTOFF_CACHE ou, à défaut, vaut $HOME/.para_cutoff.<hôte> : chaque
+   *   machine dispose ainsi de ses propres valeurs, même lorsque les
+   *   répertoires personnels sont partagés. Le programme Calibration produit
+   *   ce fichier.
+   */
+  class CutoffCache {
+  public:
+
+    /**
+     * La tolérance employée lorsqu'aucune calibration n'est disponible.
+     */
+    static constexpr size_t DEFAULT_CUTOFF = 16 * 1024;
+
+    /**
+     * Retourne la tolérance calibrée la plus adaptée. À taille d'éléments
+     * égale, la calibration du plus grand nombre de threads ne dépassant pas
+     * threads est retenue ; à défaut, la taille d'éléments calibrée la plus
+     * proche est employée.
+     *
+     * @param[in] elementSize - la taille des éléments à fusionner ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return la tolérance calibrée ou DEFAULT_CUTOFF si le cache est vide.
+     *
+     * @note Seule la taille des éléments est connue du cache : des types de
+     *   même taille (int32 et float, ou int64, double et enregistrements de
+     *   8 octets) partagent la même tolérance, celle du seul type que le
+     *   programme Calibration mesure pour cette taille (entiers, puis
+     *   enregistrements à partir de 16 octets).
+     */
+    static size_t lookup(const size_t& elementSize, const int& threads) {
+
+      std::lock_guard< std::mutex > lock(mutex());
+      const Table& entries = table();
+      if (entries.empty()) {
+	return DEFAULT_CUTOFF;
+      }
+
+      // Taille d'éléments calibrée la plus proche.
+      size_t size = entries.begin()->first.first;
+      for (const auto& entry : entries) {
+	const size_t candidate = entry.first.first;
+	const size_t distance = candidate > elementSize ?
+	  candidate - elementSize : elementSize - candidate;
+	const size_t best = size > elementSize ?
+	  size - elementSize : elementSize - size;
+	if (distance < best) {
+	  size = candidate;
+	}
+      }
+
+      // Plus grand nombre de threads calibré ne dépassant pas threads, ou
+      // plus petit nombre de threads calibré.
+      auto it = entries.upper_bound(std::make_pair(size, threads));
+      if (it != entries.begin() && std::prev(it)->first.first == size) {
+	return std::prev(it)->second;
+      }
+      return entries.lower_bound(std::make_pair(size, 0))->second;
+
+    } // lookup
+
+    /**
+     * Enregistre une tolérance calibrée (en mémoire seulement).
+     *
+     * @param[in] elementSize - la taille des éléments fusionnés ;
+     * @param[in] threads - le nombre de threads employés ;
+     * @param[in] cutoff - la meilleure tolérance mesurée.
+     */
+    static void record(const size_t& elementSize,
+		       const int& threads,
+		       const size_t& cutoff) {
+      std::lock_guard< std::mutex > lock(mutex());
+      table()[std::make_pair(elementSize, threads)] = cutoff;
+    } // record
+
+    /**
+     * Écrit toutes les tolérances connues dans le fichier cache.
+     *
+     * @return vrai si l'écriture a réussi.
+     */
+    static bool save() {
+      std::lock_guard< std::mutex > lock(mutex());
+      std::ofstream stream(path());
+      stream << "# taille_element threads cutoff" << std::endl;
+      for (const auto& entry : table()) {
+	stream << entry.first.first << ' '
+	       << entry.first.second << ' '
+	       << entry.second << std::endl;
+      }
+      return static_cast< bool >(stream);
+    } // save
+
+    /**
+     * Retourne le chemin du fichier cache.
+     *
+     * @return le chemin du fichier cache.
+     */
+    static std::string path() {
+      const char* const forced = std::getenv("PARA_CUTOFF_CACHE");
+      if (forced != nullptr) {
+	return forced;
+      }
+      char host[256] = "localhost";
+      gethostname(host, sizeof(host) - 1);
+      const char* const home = std::getenv("HOME");
+      return (home == nullptr ? std::string(".") : std::string(home))
+	+ "/.para_cutoff." + host;
+    } // path
+
+  protected:
+
+    /** Type synonyme : (taille des éléments, threads) -> tolérance. */
+    typedef std::map< std::pair< size_t, int >, size_t > Table;
+
+    /**
+     * Retourne la table des tolérances, chargée depuis le fichier cache lors
+     * du premier appel.
+     *
+     * @return la table des tolérances.
+     */
+    static Table& table() {
+      static Table entries = load();
+      return entries;
+    } // table
+
+    /**
+     * Retourne le verrou protégeant les accès à la table.
+     *
+     * @return le verrou.
+     */
+    static std::mutex& mutex() {
+      static std::mutex lock;
+      return lock;
+    } // mutex
+
+    /**
+     * Charge le fichier cache. Un fichier absent ou des lignes mal formées
+     * sont ignorés.
+     *
+     * @return la table des tolérances lues.
+     */
+    static Table load() {
+      Table entries;
+      std::ifstream stream(path());
+      std::string line;
+      while (std::getline(stream, line)) {
+	if (line.empty() || line[0] == '#') {
+	  continue;
+	}
+	std::istringstream entree(line);
+	size_t elementSize, cutoff;
+	int threads;
+	if (entree >> elementSize >> threads >> cutoff && cutoff > 0) {
+	  entries[std::make_pair(elementSize, threads)] = cutoff;
+	}
+      }
+      return entries;
+    } // load
+
+  }; // CutoffCache
+
+} // merging
+
+#endif
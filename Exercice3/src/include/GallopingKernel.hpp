@@ -0,0 +1,147 @@
+#ifndef GallopingKernel_hpp
+#define GallopingKernel_hpp
+
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+namespace merging {
+
+  /**
+   * @class GallopingKernel GallopingKernel.hpp
+   *
+   * Fusion séquentielle adaptative employée aux feuilles des algorithmes de
+   * fusion parallèle lorsque les entrées sont formées de longs blocs
+   * disjoints (entrées décalées, regroupées ou sans recouvrement).
+   *
+   * @note Les éléments sont d'abord fusionnés un à un, comme par l'algorithme
+   *   merge de la bibliothèque standard. Dès qu'un même sous-conteneur
+   *   fournit MIN_GALLOP éléments consécutifs, la fin de ce bloc est
+   *   localisée par recherche exponentielle (galop) puis dichotomique et le
+   *   bloc entier est recopié via l'algorithme copy de la bibliothèque
+   *   standard (memmove pour des éléments trivialement copiables). Le coût
+   *   est ainsi proportionnel au nombre de blocs (à un facteur logarithmique
+   *   près) et non plus au nombre d'éléments.
+   * @note Le résultat est identique à celui de l'algorithme merge de la
+   *   bibliothèque standard pour la même relation d'ordre, stricte (< ou >)
+   *   ou non (<= ou >=) : un élément du second sous-conteneur précède un
+   *   élément du premier si et seulement si comp(second, premier) est vrai.
+   */
+  class GallopingKernel {
+  public:
+
+    /**
+     * Nombre d'éléments consécutifs issus d'un même sous-conteneur à partir
+     * duquel la recherche exponentielle est employée.
+     */
+    static constexpr std::ptrdiff_t MIN_GALLOP = 7;
+
+    /**
+     * Fusion séquentielle.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp) {
+
+      InputRandomAccessIterator1 a = first1;
+      InputRandomAccessIterator2 b = first2;
+      OutputRandomAccessIterator out = result;
+
+      // Nombres d'éléments consécutifs fournis par chaque sous-conteneur.
+      std::ptrdiff_t winsA = 0, winsB = 0;
+
+      while (a != last1 && b != last2) {
+	if (comp(*b, *a)) {
+	  *out = *b;
+	  ++ out;
+	  ++ b;
+	  winsA = 0;
+	  if (++ winsB >= MIN_GALLOP && b != last2) {
+	    // Bloc du second sous-conteneur précédant *a.
+	    const InputRandomAccessIterator2 end =
+	      gallop(b, last2, [&](const auto& x) { return comp(x, *a); });
+	    out = std::copy(b, end, out);
+	    b = end;
+	    winsB = 0;
+	  }
+	}
+	else {
+	  *out = *a;
+	  ++ out;
+	  ++ a;
+	  winsB = 0;
+	  if (++ winsA >= MIN_GALLOP && a != last1) {
+	    // Bloc du premier sous-conteneur ne suivant pas *b.
+	    const InputRandomAccessIterator1 end =
+	      gallop(a, last1, [&](const auto& x) { return ! comp(*b, x); });
+	    out = std::copy(a, end, out);
+	    a = end;
+	    winsA = 0;
+	  }
+	}
+      }
+
+      // Recopie du reste de l'un des deux sous-conteneurs.
+      out = std::copy(a, last1, out);
+      return std::copy(b, last2, out);
+
+    } // apply
+
+  protected:
+
+    /**
+     * Recherche exponentielle puis dichotomique du premier élément ne
+     * vérifiant pas un prédicat vrai sur un préfixe du sous-conteneur.
+     *
+     * @param[in] first - le premier élément du sous-conteneur ;
+     * @param[in] last - la fin du sous-conteneur ;
+     * @param[in] pred - le prédicat.
+     * @return un itérateur repérant le premier élément ne vérifiant pas pred,
+     *   ou last.
+     */
+    template< typename RandomAccessIterator,
+	      typename Predicate >
+    static RandomAccessIterator gallop(const RandomAccessIterator& first,
+				       const RandomAccessIterator& last,
+				       const Predicate& pred) {
+      const std::ptrdiff_t size = last - first;
+      std::ptrdiff_t low = 0, high = 1;
+      while (high < size && pred(first[high])) {
+	low = high;
+	high = 2 * high + 1;
+      }
+      if (high > size) {
+	high = size;
+      }
+      return std::partition_point(first + low, first + high, pred);
+    } // gallop
+
+  }; // GallopingKernel
+
+} // merging
+
+#endif
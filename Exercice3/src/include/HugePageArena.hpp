@@ -0,0 +1,350 @@
+#ifndef HugePageArena_hpp
+#define HugePageArena_hpp
+
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <new>
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <sys/mman.h>
+
+namespace merging {
+
+  /**
+   * @class HugePageArena HugePageArena.hpp
+   *
+   * Arène mémoire à pages de 2 Mo : les blocs sont découpés séquentiellement
+   * (et alignés) dans des tronçons obtenus par mmap, jamais rendus
+   * individuellement. reset() rend d'un coup toute l'arène, dont les
+   * tronçons, déjà projetés, sont réutilisés tels quels par les allocations
+   * suivantes : les itérations successives d'un banc d'essai ne paient ni
+   * appel système ni défaut de page.
+   *
+   * @note Chaque tronçon est demandé en pages explicites (MAP_HUGETLB, qui
+   *   exige des pages réservées dans /proc/sys/vm/nr_hugepages), à défaut en
+   *   pages transparentes (tronçon aligné sur 2 Mo et madvise
+   *   MADV_HUGEPAGE, si /sys/kernel/mm/transparent_hugepage/enabled ne vaut
+   *   pas never), à défaut en pages normales de 4 Ko.
+   * @note allocate est protégée par un verrou : l'arène peut être partagée
+   *   entre threads, mais elle est destinée à de gros tampons peu nombreux,
+   *   pas aux allocations fines.
+   */
+  class HugePageArena {
+  public:
+
+    /**
+     * La taille d'une grande page.
+     */
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    /**
+     * Les types de pages d'un tronçon, du plus au moins favorable.
+     */
+    enum Backing {
+      EXPLICIT,      /** Grandes pages explicites (hugetlbfs). */
+      TRANSPARENT,   /** Grandes pages transparentes (THP). */
+      NORMAL         /** Pages normales. */
+    };
+
+    /**
+     * Constructeur : aucun tronçon n'est projeté avant la première
+     * allocation.
+     *
+     * @param[in] chunk - la taille minimale d'un tronçon, arrondie à un
+     *   multiple de HUGE_PAGE_SIZE ;
+     * @param[in] preferred - le type de pages essayé en premier.
+     */
+    explicit HugePageArena(const size_t& chunk = 64 * HUGE_PAGE_SIZE,
+			   const Backing& preferred = EXPLICIT)
+      : chunkSize(roundUp(chunk)), preferred(preferred), current(0),
+	offset(0) {
+    }
+
+    /**
+     * Destructeur : rend tous les tronçons au système.
+     */
+    ~HugePageArena() {
+      for (const Chunk& c : chunks) {
+	munmap(c.base, c.size);
+      }
+    }
+
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+
+    /**
+     * Alloue un bloc dans l'arène.
+     *
+     * @param[in] bytes - la taille du bloc ;
+     * @param[in] alignment - son alignement (une puissance de 2).
+     * @return l'adresse du bloc.
+     * @throw std::bad_alloc si aucun tronçon ne peut être projeté.
+     */
+    void* allocate(const size_t& bytes,
+		   const size_t& alignment = alignof(std::max_align_t)) {
+      std::lock_guard< std::mutex > lock(mutex);
+
+      // Premier tronçon (déjà projeté) pouvant accueillir le bloc.
+      for (; current < chunks.size(); current ++, offset = 0) {
+	const size_t start = align(chunks[current].base, offset, alignment);
+	if (start + bytes <= chunks[current].size) {
+	  offset = start + bytes;
+	  return chunks[current].base + start;
+	}
+      }
+
+      // Nouveau tronçon, assez grand pour le bloc.
+      Chunk c;
+      c.size = roundUp(std::max(chunkSize, bytes + alignment));
+      c.base = static_cast< char* >(map(c.size, preferred, c.backing));
+      chunks.push_back(c);
+      current = chunks.size() - 1;
+      const size_t start = align(c.base, 0, alignment);
+      offset = start + bytes;
+      return c.base + start;
+    }
+
+    /**
+     * Rend tous les blocs : les tronçons restent projetés et seront
+     * réutilisés. Les blocs précédemment alloués ne doivent plus servir.
+     */
+    void reset() {
+      std::lock_guard< std::mutex > lock(mutex);
+      current = 0;
+      offset = 0;
+    }
+
+    /**
+     * Retourne le type de pages le moins favorable des tronçons projetés.
+     *
+     * @return le type de pages, preferred si aucun tronçon n'est projeté.
+     */
+    Backing backing() const {
+      std::lock_guard< std::mutex > lock(mutex);
+      Backing worst = preferred;
+      for (const Chunk& c : chunks) {
+	worst = std::max(worst, c.backing);
+      }
+      return worst;
+    }
+
+    /**
+     * Retourne la taille totale des tronçons projetés.
+     *
+     * @return la taille projetée en octets.
+     */
+    size_t reserved() const {
+      std::lock_guard< std::mutex > lock(mutex);
+      size_t total = 0;
+      for (const Chunk& c : chunks) {
+	total += c.size;
+      }
+      return total;
+    }
+
+    /**
+     * Retourne le nom d'un type de pages.
+     *
+     * @param[in] backing - le type de pages.
+     * @return son nom.
+     */
+    static const char* name(const Backing& backing) {
+      static const char* const names[] = {
+	"explicites", "transparentes", "normales"
+      };
+      return names[backing];
+    }
+
+  protected:
+
+    /**
+     * Un tronçon projeté.
+     */
+    struct Chunk {
+      char* base;        /** Son adresse. */
+      size_t size;       /** Sa taille. */
+      Backing backing;   /** Son type de pages. */
+    };
+
+    /**
+     * Arrondit une taille au multiple de HUGE_PAGE_SIZE supérieur.
+     *
+     * @param[in] bytes - la taille.
+     * @return la taille arrondie, au moins HUGE_PAGE_SIZE.
+     */
+    static size_t roundUp(const size_t& bytes) {
+      const size_t pages = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE;
+      return std::max< size_t >(pages, 1) * HUGE_PAGE_SIZE;
+    }
+
+    /**
+     * Aligne un décalage au sein d'un tronçon.
+     *
+     * @param[in] base - l'adresse du tronçon ;
+     * @param[in] offset - le décalage ;
+     * @param[in] alignment - l'alignement.
+     * @return le premier décalage aligné, au moins égal à offset.
+     */
+    static size_t align(const char* base, const size_t& offset,
+			const size_t& alignment) {
+      const std::uintptr_t address =
+	reinterpret_cast< std::uintptr_t >(base) + offset;
+      const std::uintptr_t aligned =
+	(address + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+      return offset + (aligned - address);
+    }
+
+    /**
+     * Indique si les pages transparentes sont désactivées par le système.
+     *
+     * @return vrai si leur mode vaut never.
+     */
+    static bool transparentDisabled() {
+      std::ifstream stream("/sys/kernel/mm/transparent_hugepage/enabled");
+      std::string mode;
+      std::getline(stream, mode);
+      return mode.find("[never]") != std::string::npos;
+    }
+
+    /**
+     * Projette un tronçon avec le meilleur type de pages disponible, à
+     * partir de preferred.
+     *
+     * @param[in] size - la taille du tronçon, multiple de HUGE_PAGE_SIZE ;
+     * @param[in] preferred - le type de pages essayé en premier ;
+     * @param[out] backing - le type de pages obtenu.
+     * @return l'adresse du tronçon, alignée sur HUGE_PAGE_SIZE sauf en pages
+     *   normales.
+     * @throw std::bad_alloc si la projection échoue.
+     */
+    static void* map(const size_t& size, const Backing& preferred,
+		     Backing& backing) {
+      const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined(MAP_HUGETLB)
+      // Grandes pages explicites, alignées par construction.
+      if (preferred == EXPLICIT) {
+#if defined(MAP_HUGE_SHIFT)
+	const int huge = MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+#else
+	const int huge = MAP_HUGETLB;
+#endif
+	void* const p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+			     flags | huge, -1, 0);
+	if (p != MAP_FAILED) {
+	  backing = EXPLICIT;
+	  return p;
+	}
+      }
+#endif
+
+#if defined(MADV_HUGEPAGE)
+      // Grandes pages transparentes : projection agrandie d'une grande page
+      // puis rognée pour que le tronçon soit aligné sur 2 Mo.
+      if (preferred <= TRANSPARENT && ! transparentDisabled()) {
+	void* const p = mmap(nullptr, size + HUGE_PAGE_SIZE,
+			     PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (p != MAP_FAILED) {
+	  char* const raw = static_cast< char* >(p);
+	  char* const base = raw + align(raw, 0, HUGE_PAGE_SIZE);
+	  if (base != raw) {
+	    munmap(raw, base - raw);
+	  }
+	  munmap(base + size, raw + HUGE_PAGE_SIZE - base);
+	  if (madvise(base, size, MADV_HUGEPAGE) == 0) {
+	    backing = TRANSPARENT;
+	    return base;
+	  }
+	  munmap(base, size);
+	}
+      }
+#endif
+
+      // Pages normales.
+      void* const p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1,
+			   0);
+      if (p == MAP_FAILED) {
+	throw std::bad_alloc();
+      }
+      backing = NORMAL;
+      return p;
+    }
+
+  private:
+
+    const size_t chunkSize;        /** Taille minimale d'un tronçon. */
+    const Backing preferred;       /** Type de pages essayé en premier. */
+    std::vector< Chunk > chunks;   /** Les tronçons projetés. */
+    size_t current;                /** Le tronçon courant. */
+    size_t offset;                 /** Le décalage libre du tronçon courant. */
+    mutable std::mutex mutex;      /** Le verrou des allocations. */
+
+  }; // HugePageArena
+
+  /**
+   * @class ArenaAllocator HugePageArena.hpp
+   *
+   * Allocateur puisant dans une HugePageArena, par exemple pour
+   * std::vector< T, ArenaAllocator< T > >. La désallocation est sans effet :
+   * la mémoire est rendue par HugePageArena::reset.
+   */
+  template< typename T >
+  class ArenaAllocator {
+  public:
+
+    typedef T value_type;
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] arena - l'arène.
+     */
+    explicit ArenaAllocator(HugePageArena& arena) noexcept : arena(&arena) {
+    }
+
+    template< typename U >
+    ArenaAllocator(const ArenaAllocator< U >& other) noexcept
+      : arena(other.arena) {
+    }
+
+    /**
+     * Alloue n éléments non construits.
+     *
+     * @param[in] n - le nombre d'éléments.
+     * @return l'adresse du premier élément.
+     */
+    T* allocate(const size_t n) {
+      return static_cast< T* >(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * Désallocation sans effet.
+     */
+    void deallocate(T*, const size_t) noexcept {
+    }
+
+    template< typename U >
+    bool operator==(const ArenaAllocator< U >& other) const noexcept {
+      return arena == other.arena;
+    }
+
+    template< typename U >
+    bool operator!=(const ArenaAllocator< U >& other) const noexcept {
+      return arena != other.arena;
+    }
+
+  private:
+
+    template< typename U >
+    friend class ArenaAllocator;
+
+    HugePageArena* arena;   /** L'arène. */
+
+  }; // ArenaAllocator
+
+} // merging
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef KeyMergeKernel_hpp
+#define KeyMergeKernel_hpp
+
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+namespace merging {
+
+  /**
+   * @class KeyMergeKernel KeyMergeKernel.hpp
+   *
+   * Fusion séquentielle par clé employée aux feuilles des fusions parallèles
+   * par clé (ParallelRecursiveMerge::applyByKey,
+   * ParallelStableMerge::applyByKey) : les enregistrements sont rangés en
+   * colonnes (structure de tableaux), seules les clés sont fusionnées et la
+   * fusion produit, en plus des clés fusionnées, la permutation qui indique
+   * pour chaque position du résultat l'enregistrement source. Les colonnes
+   * de charge utile sont ensuite rassemblées (gather) une à une selon cette
+   * permutation, au lieu de déplacer des enregistrements entiers à chaque
+   * comparaison.
+   *
+   * @note Les enregistrements sources sont numérotés de 0 à m - 1 pour le
+   *   premier sous-conteneur et de m à m + n - 1 pour le second.
+   * @note La boucle de fusion est sans branchement dépendant des données :
+   *   la source de chaque élément est choisie par des affectations
+   *   conditionnelles.
+   */
+  class KeyMergeKernel {
+  public:
+
+    /**
+     * Projection identité : la clé est comparée telle quelle.
+     */
+    struct Identity {
+      template< typename T >
+      const T& operator()(const T& x) const {
+	return x;
+      }
+    };
+
+    /**
+     * Fusion séquentielle par clé.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier sous-conteneur ;
+     * @param[in] base1 - le numéro de l'enregistrement de la première clé du
+     *   premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second sous-conteneur ;
+     * @param[in] base2 - le numéro de l'enregistrement de la première clé du
+     *   second sous-conteneur ;
+     * @param[out] keys - un itérateur repérant la position où recopier la
+     *   première clé fusionnée ;
+     * @param[out] permutation - un itérateur repérant la position où écrire
+     *   le numéro de l'enregistrement de la première clé fusionnée ;
+     * @param[in] before - un prédicat binaire, vrai lorsqu'une clé
+     *   (projetée) du premier sous-conteneur précède une clé (projetée) du
+     *   second : !comp(b, a) pour un ordre strict comp, comp(a, b) pour un
+     *   ordre de type <= ;
+     * @param[in] projection - la projection appliquée aux clés avant
+     *   comparaison.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename KeyRandomAccessIterator,
+	      typename IndexRandomAccessIterator,
+	      typename Index,
+	      typename Before,
+	      typename Projection >
+    static void
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const Index& base1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const Index& base2,
+	  const KeyRandomAccessIterator& keys,
+	  const IndexRandomAccessIterator& permutation,
+	  const Before& before,
+	  const Projection& projection) {
+      typedef typename std::iterator_traits< KeyRandomAccessIterator >
+	::difference_type Size;
+      const Size m = last1 - first1;
+      const Size n = last2 - first2;
+      Size i = 0, j = 0, k = 0;
+
+      // Fusion sans branchement tant que les deux sources sont non vides.
+      while (i < m && j < n) {
+	const auto& a = first1[i];
+	const auto& b = first2[j];
+	const bool first = before(projection(a), projection(b));
+	keys[k] = first ? a : b;
+	permutation[k] = first ? static_cast< Index >(base1 + i) :
+	  static_cast< Index >(base2 + j);
+	i += first;
+	j += ! first;
+	k ++;
+      }
+
+      // Recopie de la fin de la source restante.
+      for (; i < m; i ++, k ++) {
+	keys[k] = first1[i];
+	permutation[k] = static_cast< Index >(base1 + i);
+      }
+      for (; j < n; j ++, k ++) {
+	keys[k] = first2[j];
+	permutation[k] = static_cast< Index >(base2 + j);
+      }
+    } // apply
+
+    /**
+     * Rassemble séquentiellement une colonne selon une permutation.
+     *
+     * @param[in] first - un itérateur repérant le premier numéro de la
+     *   permutation concerné ;
+     * @param[in] last - un itérateur repérant la position située juste
+     *   derrière le dernier numéro concerné ;
+     * @param[in] m - le nombre d'enregistrements du premier sous-conteneur ;
+     * @param[in] column1 - un itérateur repérant la colonne du premier
+     *   sous-conteneur ;
+     * @param[in] column2 - un itérateur repérant la colonne du second
+     *   sous-conteneur ;
+     * @param[out] result - un itérateur repérant la position où recopier la
+     *   valeur du premier numéro concerné.
+     */
+    template< typename IndexRandomAccessIterator,
+	      typename Index,
+	      typename ColumnRandomAccessIterator1,
+	      typename ColumnRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static void
+    gather(const IndexRandomAccessIterator& first,
+	   const IndexRandomAccessIterator& last,
+	   const Index& m,
+	   const ColumnRandomAccessIterator1& column1,
+	   const ColumnRandomAccessIterator2& column2,
+	   const OutputRandomAccessIterator& result) {
+      const auto size = last - first;
+      for (decltype(last - first) k = 0; k < size; k ++) {
+	const Index p = first[k];
+	if (p < m) {
+	  result[k] = column1[p];
+	}
+	else {
+	  result[k] = column2[p - m];
+	}
+      }
+    } // gather
+
+  }; // KeyMergeKernel
+
+} // merging
+
+#endif
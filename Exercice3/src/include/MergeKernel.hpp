@@ -0,0 +1,704 @@
+#ifndef MergeKernel_hpp
+#define MergeKernel_hpp
+
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace merging {
+
+  /**
+   * @class MergeKernel MergeKernel.hpp
+   *
+   * Fusion séquentielle employée aux feuilles des algorithmes de fusion
+   * parallèle.
+   *
+   * @note Lorsque les itérateurs sont contigus (pointeurs ou itérateurs de
+   *   std::vector), que les éléments sont des int32, int64, float ou double
+   *   et que la relation d'ordre est std::less, std::greater (ou leurs
+   *   variantes <= et >=), la fusion est effectuée par blocs de registres
+   *   AVX-512 ou AVX2 via un réseau de fusion bitonique, sans branchement
+   *   dépendant des données ; la fin est traitée en scalaire. Le choix est
+   *   fait à la compilation (-mavx2, -mavx512f ou -march=native, ajouté par
+   *   l'option CMake MERGE_NATIVE, désactivée par défaut). Dans tous
+   *   les autres cas, la fusion est déléguée à l'algorithme merge de la
+   *   bibliothèque standard.
+   * @note Des std::move_iterator sur des éléments trivialement copiables
+   *   sont traités comme les itérateurs qu'ils enveloppent.
+   * @note Pour les flottants, les NaN ne sont pas supportés (comme pour
+   *   std::less) et l'ordre relatif de -0.0 et +0.0 n'est pas garanti.
+   */
+  class MergeKernel {
+  public:
+
+    /**
+     * Fusion séquentielle.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp) {
+
+      typedef typename std::iterator_traits< OutputRandomAccessIterator >
+	::value_type value_type;
+      typedef Simd< value_type > S;
+      const int order = Order< Compare, value_type >::value;
+
+      // Déplacer des éléments trivialement copiables revient à les recopier :
+      // les itérateurs de déplacement sont retirés pour permettre la
+      // vectorisation.
+      if constexpr (Moving< InputRandomAccessIterator1 >::value &&
+		    Moving< InputRandomAccessIterator2 >::value &&
+		    std::is_trivially_copyable< value_type >::value) {
+	return apply(first1.base(), last1.base(),
+		     first2.base(), last2.base(),
+		     result,
+		     comp);
+      }
+      else if constexpr (S::available && order != 0 &&
+		    Contiguous< InputRandomAccessIterator1, value_type >::value &&
+		    Contiguous< InputRandomAccessIterator2, value_type >::value &&
+		    Contiguous< OutputRandomAccessIterator, value_type >::value &&
+		    ! std::is_const< typename std::remove_reference<
+		      decltype(*result) >::type >::value) {
+	const auto size1 = last1 - first1;
+	const auto size2 = last2 - first2;
+	if (size1 + size2 == 0) {
+	  return result;
+	}
+	const value_type* a = size1 == 0 ? nullptr : &*first1;
+	const value_type* b = size2 == 0 ? nullptr : &*first2;
+	value_type* out = &*result;
+	mergeVector< S, (order < 0) >(a, a + size1, b, b + size2, out);
+	return result + (size1 + size2);
+      }
+      else {
+	return std::merge(first1, last1, first2, last2, result, comp);
+      }
+
+    } // apply
+
+  protected:
+
+    /**
+     * Vrai si le paramètre X d'un comparateur standard désigne T (à une
+     * référence ou un const près) ou void (comparateur transparent).
+     */
+    template< typename X, typename T >
+    struct Same {
+      static const bool value =
+	std::is_void< X >::value ||
+	std::is_same< typename std::decay< X >::type, T >::value;
+    };
+
+    /**
+     * Sens de la relation d'ordre : 1 pour croissant, -1 pour décroissant et
+     * 0 si elle n'est pas reconnue.
+     */
+    template< typename Compare, typename T >
+    struct Order {
+      static const int value = 0;
+    };
+
+    template< typename X, typename T >
+    struct Order< std::less< X >, T > {
+      static const int value = Same< X, T >::value ? 1 : 0;
+    };
+
+    template< typename X, typename T >
+    struct Order< std::less_equal< X >, T > {
+      static const int value = Same< X, T >::value ? 1 : 0;
+    };
+
+    template< typename X, typename T >
+    struct Order< std::greater< X >, T > {
+      static const int value = Same< X, T >::value ? -1 : 0;
+    };
+
+    template< typename X, typename T >
+    struct Order< std::greater_equal< X >, T > {
+      static const int value = Same< X, T >::value ? -1 : 0;
+    };
+
+    /**
+     * Vrai si l'itérateur repère des éléments de type T contigus en mémoire.
+     */
+    template< typename Iterator, typename T >
+    struct Contiguous {
+      typedef typename std::remove_const< T >::type U;
+      static const bool value =
+	std::is_same< Iterator, U* >::value ||
+	std::is_same< Iterator, const U* >::value ||
+	std::is_same< Iterator, typename std::vector< U >::iterator >::value ||
+	std::is_same< Iterator,
+		      typename std::vector< U >::const_iterator >::value;
+    };
+
+#if defined(__GLIBCXX__)
+    /**
+     * Avec libstdc++, les itérateurs de std::vector sont reconnus quel que
+     * soit l'allocateur (FirstTouchAllocator, par exemple).
+     */
+    template< typename Pointer, typename Container, typename T >
+    struct Contiguous< __gnu_cxx::__normal_iterator< Pointer, Container >, T > {
+      typedef typename std::remove_const< T >::type U;
+      static const bool value =
+	std::is_same< Pointer, U* >::value ||
+	std::is_same< Pointer, const U* >::value;
+    };
+#endif
+
+    /**
+     * Vrai si l'itérateur est un std::move_iterator.
+     */
+    template< typename Iterator >
+    struct Moving {
+      static const bool value = false;
+    };
+
+    template< typename Iterator >
+    struct Moving< std::move_iterator< Iterator > > {
+      static const bool value = true;
+    };
+
+    /**
+     * Jeu d'instructions vectorielles associé au type T (aucun par défaut).
+     */
+    template< typename T, typename Enable = void >
+    struct Simd {
+      static const bool available = false;
+    };
+
+#if defined(__AVX512F__)
+
+    /**
+     * Masque des voies dont le bit d'indice d est positionné.
+     */
+    static constexpr unsigned laneMask(const int& width, const int& d) {
+      unsigned mask = 0;
+      for (int i = 0; i < width; i ++) {
+	if (i & d) {
+	  mask |= 1u << i;
+	}
+      }
+      return mask;
+    }
+
+    /**
+     * 16 voies de 32 bits (int32 ou float) en AVX-512.
+     */
+    template< typename T, typename Ops >
+    struct Avx512x16 {
+      static const bool available = true;
+      static const int width = 16;
+      static const int stages = 4;
+      typedef typename Ops::vector V;
+      typedef V vector;
+
+      static V load(const T* p) { return Ops::load(p); }
+      static void store(T* p, const V& v) { Ops::store(p, v); }
+      static V min(const V& a, const V& b) { return Ops::min(a, b); }
+      static V max(const V& a, const V& b) { return Ops::max(a, b); }
+
+      static V reverse(const V& v) {
+	return Ops::permute(_mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+					      7, 6, 5, 4, 3, 2, 1, 0), v);
+      }
+
+      template< int Stage >
+      static V exchange(const V& v) {
+	const int d = width >> (Stage + 1);
+	return Ops::permute(_mm512_xor_si512(_mm512_setr_epi32(0, 1, 2, 3,
+							       4, 5, 6, 7,
+							       8, 9, 10, 11,
+							       12, 13, 14, 15),
+					     _mm512_set1_epi32(d)), v);
+      }
+
+      template< int Stage >
+      static V select(const V& lo, const V& hi) {
+	return Ops::blend(static_cast< __mmask16 >(
+			    laneMask(width, width >> (Stage + 1))), lo, hi);
+      }
+    };
+
+    /**
+     * 8 voies de 64 bits (int64 ou double) en AVX-512.
+     */
+    template< typename T, typename Ops >
+    struct Avx512x8 {
+      static const bool available = true;
+      static const int width = 8;
+      static const int stages = 3;
+      typedef typename Ops::vector V;
+      typedef V vector;
+
+      static V load(const T* p) { return Ops::load(p); }
+      static void store(T* p, const V& v) { Ops::store(p, v); }
+      static V min(const V& a, const V& b) { return Ops::min(a, b); }
+      static V max(const V& a, const V& b) { return Ops::max(a, b); }
+
+      static V reverse(const V& v) {
+	return Ops::permute(_mm512_setr_epi64(7, 6, 5, 4, 3, 2, 1, 0), v);
+      }
+
+      template< int Stage >
+      static V exchange(const V& v) {
+	const int d = width >> (Stage + 1);
+	return Ops::permute(_mm512_xor_si512(_mm512_setr_epi64(0, 1, 2, 3,
+							       4, 5, 6, 7),
+					     _mm512_set1_epi64(d)), v);
+      }
+
+      template< int Stage >
+      static V select(const V& lo, const V& hi) {
+	return Ops::blend(static_cast< __mmask8 >(
+			    laneMask(width, width >> (Stage + 1))), lo, hi);
+      }
+    };
+
+    /**
+     * Opérations AVX-512 sur les int32. Les variantes masquées par zéro
+     * (masque plein) produisent les mêmes instructions que les variantes
+     * simples sans exposer de registre indéfini au compilateur.
+     */
+    struct Avx512Int32 {
+      typedef __m512i vector;
+      static __m512i load(const void* p) { return _mm512_loadu_si512(p); }
+      static void store(void* p, const __m512i& v) { _mm512_storeu_si512(p, v); }
+      static __m512i min(const __m512i& a, const __m512i& b) { return _mm512_maskz_min_epi32(0xFFFF, a, b); }
+      static __m512i max(const __m512i& a, const __m512i& b) { return _mm512_maskz_max_epi32(0xFFFF, a, b); }
+      static __m512i permute(const __m512i& i, const __m512i& v) { return _mm512_maskz_permutexvar_epi32(0xFFFF, i, v); }
+      static __m512i blend(const __mmask16& k, const __m512i& a, const __m512i& b) { return _mm512_mask_blend_epi32(k, a, b); }
+    };
+
+    /** Opérations AVX-512 sur les float. */
+    struct Avx512Float {
+      typedef __m512 vector;
+      static __m512 load(const float* p) { return _mm512_loadu_ps(p); }
+      static void store(float* p, const __m512& v) { _mm512_storeu_ps(p, v); }
+      static __m512 min(const __m512& a, const __m512& b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+      static __m512 max(const __m512& a, const __m512& b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+      static __m512 permute(const __m512i& i, const __m512& v) { return _mm512_maskz_permutexvar_ps(0xFFFF, i, v); }
+      static __m512 blend(const __mmask16& k, const __m512& a, const __m512& b) { return _mm512_mask_blend_ps(k, a, b); }
+    };
+
+    /** Opérations AVX-512 sur les int64. */
+    struct Avx512Int64 {
+      typedef __m512i vector;
+      static __m512i load(const void* p) { return _mm512_loadu_si512(p); }
+      static void store(void* p, const __m512i& v) { _mm512_storeu_si512(p, v); }
+      static __m512i min(const __m512i& a, const __m512i& b) { return _mm512_maskz_min_epi64(0xFF, a, b); }
+      static __m512i max(const __m512i& a, const __m512i& b) { return _mm512_maskz_max_epi64(0xFF, a, b); }
+      static __m512i permute(const __m512i& i, const __m512i& v) { return _mm512_maskz_permutexvar_epi64(0xFF, i, v); }
+      static __m512i blend(const __mmask8& k, const __m512i& a, const __m512i& b) { return _mm512_mask_blend_epi64(k, a, b); }
+    };
+
+    /** Opérations AVX-512 sur les double. */
+    struct Avx512Double {
+      typedef __m512d vector;
+      static __m512d load(const double* p) { return _mm512_loadu_pd(p); }
+      static void store(double* p, const __m512d& v) { _mm512_storeu_pd(p, v); }
+      static __m512d min(const __m512d& a, const __m512d& b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+      static __m512d max(const __m512d& a, const __m512d& b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+      static __m512d permute(const __m512i& i, const __m512d& v) { return _mm512_maskz_permutexvar_pd(0xFF, i, v); }
+      static __m512d blend(const __mmask8& k, const __m512d& a, const __m512d& b) { return _mm512_mask_blend_pd(k, a, b); }
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_integral< T >::value &&
+					     std::is_signed< T >::value &&
+					     sizeof(T) == 4 >::type >
+      : Avx512x16< T, Avx512Int32 > {
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_integral< T >::value &&
+					     std::is_signed< T >::value &&
+					     sizeof(T) == 8 >::type >
+      : Avx512x8< T, Avx512Int64 > {
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_same< T, float >::value >::type >
+      : Avx512x16< T, Avx512Float > {
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_same< T, double >::value >::type >
+      : Avx512x8< T, Avx512Double > {
+    };
+
+#elif defined(__AVX2__)
+
+    /**
+     * 8 voies de 32 bits signés en AVX2.
+     */
+    template< typename T >
+    struct Avx2Int32 {
+      static const bool available = true;
+      static const int width = 8;
+      static const int stages = 3;
+      typedef __m256i vector;
+
+      static __m256i load(const T* p) {
+	return _mm256_loadu_si256(reinterpret_cast< const __m256i* >(p));
+      }
+      static void store(T* p, const __m256i& v) {
+	_mm256_storeu_si256(reinterpret_cast< __m256i* >(p), v);
+      }
+      static __m256i min(const __m256i& a, const __m256i& b) { return _mm256_min_epi32(a, b); }
+      static __m256i max(const __m256i& a, const __m256i& b) { return _mm256_max_epi32(a, b); }
+
+      static __m256i reverse(const __m256i& v) {
+	return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4,
+								3, 2, 1, 0));
+      }
+
+      template< int Stage >
+      static __m256i exchange(const __m256i& v) {
+	if constexpr (Stage == 0) {
+	  return _mm256_permute2x128_si256(v, v, 0x01);
+	}
+	else if constexpr (Stage == 1) {
+	  return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+	else {
+	  return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+	}
+      }
+
+      template< int Stage >
+      static __m256i select(const __m256i& lo, const __m256i& hi) {
+	if constexpr (Stage == 0) {
+	  return _mm256_blend_epi32(lo, hi, 0xF0);
+	}
+	else if constexpr (Stage == 1) {
+	  return _mm256_blend_epi32(lo, hi, 0xCC);
+	}
+	else {
+	  return _mm256_blend_epi32(lo, hi, 0xAA);
+	}
+      }
+    };
+
+    /**
+     * 8 voies de float en AVX2.
+     */
+    struct Avx2Float {
+      static const bool available = true;
+      static const int width = 8;
+      static const int stages = 3;
+      typedef __m256 vector;
+
+      static __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+      static void store(float* p, const __m256& v) { _mm256_storeu_ps(p, v); }
+      static __m256 min(const __m256& a, const __m256& b) { return _mm256_min_ps(a, b); }
+      static __m256 max(const __m256& a, const __m256& b) { return _mm256_max_ps(a, b); }
+
+      static __m256 reverse(const __m256& v) {
+	return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4,
+							     3, 2, 1, 0));
+      }
+
+      template< int Stage >
+      static __m256 exchange(const __m256& v) {
+	if constexpr (Stage == 0) {
+	  return _mm256_permute2f128_ps(v, v, 0x01);
+	}
+	else if constexpr (Stage == 1) {
+	  return _mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+	else {
+	  return _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+	}
+      }
+
+      template< int Stage >
+      static __m256 select(const __m256& lo, const __m256& hi) {
+	if constexpr (Stage == 0) {
+	  return _mm256_blend_ps(lo, hi, 0xF0);
+	}
+	else if constexpr (Stage == 1) {
+	  return _mm256_blend_ps(lo, hi, 0xCC);
+	}
+	else {
+	  return _mm256_blend_ps(lo, hi, 0xAA);
+	}
+      }
+    };
+
+    /**
+     * 4 voies de 64 bits signés en AVX2 (min et max émulés par comparaison).
+     */
+    template< typename T >
+    struct Avx2Int64 {
+      static const bool available = true;
+      static const int width = 4;
+      static const int stages = 2;
+      typedef __m256i vector;
+
+      static __m256i load(const T* p) {
+	return _mm256_loadu_si256(reinterpret_cast< const __m256i* >(p));
+      }
+      static void store(T* p, const __m256i& v) {
+	_mm256_storeu_si256(reinterpret_cast< __m256i* >(p), v);
+      }
+      static __m256i min(const __m256i& a, const __m256i& b) {
+	return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+      }
+      static __m256i max(const __m256i& a, const __m256i& b) {
+	return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+      }
+
+      static __m256i reverse(const __m256i& v) {
+	return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+      }
+
+      template< int Stage >
+      static __m256i exchange(const __m256i& v) {
+	if constexpr (Stage == 0) {
+	  return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+	else {
+	  return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1));
+	}
+      }
+
+      template< int Stage >
+      static __m256i select(const __m256i& lo, const __m256i& hi) {
+	if constexpr (Stage == 0) {
+	  return _mm256_blend_epi32(lo, hi, 0xF0);
+	}
+	else {
+	  return _mm256_blend_epi32(lo, hi, 0xCC);
+	}
+      }
+    };
+
+    /**
+     * 4 voies de double en AVX2.
+     */
+    struct Avx2Double {
+      static const bool available = true;
+      static const int width = 4;
+      static const int stages = 2;
+      typedef __m256d vector;
+
+      static __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+      static void store(double* p, const __m256d& v) { _mm256_storeu_pd(p, v); }
+      static __m256d min(const __m256d& a, const __m256d& b) { return _mm256_min_pd(a, b); }
+      static __m256d max(const __m256d& a, const __m256d& b) { return _mm256_max_pd(a, b); }
+
+      static __m256d reverse(const __m256d& v) {
+	return _mm256_permute4x64_pd(v, _MM_SHUFFLE(0, 1, 2, 3));
+      }
+
+      template< int Stage >
+      static __m256d exchange(const __m256d& v) {
+	if constexpr (Stage == 0) {
+	  return _mm256_permute2f128_pd(v, v, 0x01);
+	}
+	else {
+	  return _mm256_permute_pd(v, 0x5);
+	}
+      }
+
+      template< int Stage >
+      static __m256d select(const __m256d& lo, const __m256d& hi) {
+	if constexpr (Stage == 0) {
+	  return _mm256_blend_pd(lo, hi, 0xC);
+	}
+	else {
+	  return _mm256_blend_pd(lo, hi, 0xA);
+	}
+      }
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_integral< T >::value &&
+					     std::is_signed< T >::value &&
+					     sizeof(T) == 4 >::type >
+      : Avx2Int32< T > {
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_integral< T >::value &&
+					     std::is_signed< T >::value &&
+					     sizeof(T) == 8 >::type >
+      : Avx2Int64< T > {
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_same< T, float >::value >::type >
+      : Avx2Float {
+    };
+
+    template< typename T >
+    struct Simd< T, typename std::enable_if< std::is_same< T, double >::value >::type >
+      : Avx2Double {
+    };
+
+#endif
+
+    /**
+     * Trie un registre bitonique : à l'étape s, chaque voie est comparée à
+     * celle située à la distance width / 2^(s+1).
+     */
+    template< typename S,
+	      bool Descending,
+	      int Stage = 0 >
+    static typename S::vector clean(const typename S::vector& v) {
+      if constexpr (Stage == S::stages) {
+	return v;
+      }
+      else {
+	const typename S::vector p = S::template exchange< Stage >(v);
+	const typename S::vector lo = Descending ? S::max(v, p) : S::min(v, p);
+	const typename S::vector hi = Descending ? S::min(v, p) : S::max(v, p);
+	return clean< S, Descending, Stage + 1 >(S::template select< Stage >(lo,
+									     hi));
+      }
+    }
+
+    /**
+     * Fusionne deux registres triés : a reçoit les width premiers éléments et
+     * b les width suivants.
+     */
+    template< typename S,
+	      bool Descending >
+    static void mergeRegisters(typename S::vector& a, typename S::vector& b) {
+      const typename S::vector r = S::reverse(b);
+      const typename S::vector lo = Descending ? S::max(a, r) : S::min(a, r);
+      const typename S::vector hi = Descending ? S::min(a, r) : S::max(a, r);
+      a = clean< S, Descending >(lo);
+      b = clean< S, Descending >(hi);
+    }
+
+    /**
+     * Vrai si x doit précéder strictement y.
+     */
+    template< bool Descending,
+	      typename T >
+    static bool before(const T& x, const T& y) {
+      return Descending ? y < x : x < y;
+    }
+
+    /**
+     * Fusion scalaire sans branchement dépendant des données.
+     */
+    template< bool Descending,
+	      typename T >
+    static T* mergeScalar(const T* a, const T* ea,
+			  const T* b, const T* eb,
+			  T* out) {
+      while (a != ea && b != eb) {
+	const bool takeB = before< Descending >(*b, *a);
+	*out = takeB ? *b : *a;
+	++ out;
+	a += ! takeB;
+	b += takeB;
+      }
+      out = std::copy(a, ea, out);
+      return std::copy(b, eb, out);
+    }
+
+    /**
+     * Fusion vectorielle : un registre issu de l'entrée dont la tête est la
+     * plus petite est fusionné avec les width plus grands éléments de l'étape
+     * précédente ; les width plus petits sont écrits. Lorsqu'une entrée ne
+     * contient plus un registre complet, les éléments en attente et les deux
+     * restes sont fusionnés en scalaire.
+     */
+    template< typename S,
+	      bool Descending,
+	      typename T >
+    static T* mergeVector(const T* a, const T* ea,
+			  const T* b, const T* eb,
+			  T* out) {
+      const std::ptrdiff_t width = S::width;
+      if (ea - a < width || eb - b < width) {
+	return mergeScalar< Descending >(a, ea, b, eb, out);
+      }
+
+      typename S::vector va = S::load(a);
+      typename S::vector vb = S::load(b);
+      a += width;
+      b += width;
+      mergeRegisters< S, Descending >(va, vb);
+      S::store(out, va);
+      out += width;
+      while (ea - a >= width && eb - b >= width) {
+	const bool takeB = before< Descending >(*b, *a);
+	const T* next = takeB ? b : a;
+	a += takeB ? 0 : width;
+	b += takeB ? width : 0;
+	va = S::load(next);
+	mergeRegisters< S, Descending >(va, vb);
+	S::store(out, va);
+	out += width;
+      }
+
+      // Fusion à trois voies des éléments en attente et des deux restes.
+      alignas(64) T pending[S::width];
+      S::store(pending, vb);
+      const T* c = pending;
+      const T* ec = pending + width;
+      while (c != ec && a != ea && b != eb) {
+	if (before< Descending >(*a, *c) && ! before< Descending >(*b, *a)) {
+	  *out = *a;
+	  ++ a;
+	}
+	else if (before< Descending >(*b, *c)) {
+	  *out = *b;
+	  ++ b;
+	}
+	else {
+	  *out = *c;
+	  ++ c;
+	}
+	++ out;
+      }
+      if (c == ec) {
+	return mergeScalar< Descending >(a, ea, b, eb, out);
+      }
+      if (a == ea) {
+	return mergeScalar< Descending >(c, ec, b, eb, out);
+      }
+      return mergeScalar< Descending >(c, ec, a, ea, out);
+    }
+
+  }; // MergeKernel
+
+} // merging
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef ParallelInplaceMerge_hpp
+#define ParallelInplaceMerge_hpp
+
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <tbb/tbb.h>
+
+namespace merging {
+
+  /**
+   * @class ParallelInplaceMerge ParallelInplaceMerge.hpp
+   *
+   * Version TBB de l'algorithme inplace_merge de la bibliothèque standard :
+   * fusion de deux sous-conteneurs triés adjacents sans conteneur cible.
+   *
+   * @note Comme ParallelRecursiveMerge, l'élément médian du plus long des deux
+   *   sous-conteneurs est localisé dans l'autre par recherche dichotomique. Au
+   *   lieu d'être recopiés dans un conteneur cible, les deux blocs centraux
+   *   sont échangés par une rotation (trois renversements parallèles), ce qui
+   *   produit deux fusions indépendantes confiées à deux tâches TBB. Sous une
+   *   certaine tolérance, la fusion est effectuée via l'algorithme
+   *   inplace_merge de la bibliothèque standard, qui alloue un tampon d'au
+   *   plus cutoff éléments : la mémoire supplémentaire est ainsi bornée par
+   *   O(threads * cutoff) au lieu de O(n).
+   * @note Contrairement à ParallelRecursiveMerge, cette fusion est stable.
+   */
+  class ParallelInplaceMerge {
+  public:
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] middle - un itérateur repérant le premier élément du second
+     *   sous-conteneur, situé juste derrière le premier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total (strict) régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée via l'algorithme
+     *   inplace_merge de la bibliothèque standard.
+     */
+    template< typename RandomAccessIterator,
+	      typename Compare >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& middle,
+		      const RandomAccessIterator& last,
+		      const Compare& comp,
+		      const size_t& cutoff) {
+
+      mergeRecursive(first, middle, last, comp, std::max< size_t >(cutoff, 2));
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] middle - un itérateur repérant le premier élément du second
+     *   sous-conteneur, situé juste derrière le premier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée via l'algorithme
+     *   inplace_merge de la bibliothèque standard.
+     */
+    template< typename RandomAccessIterator >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& middle,
+		      const RandomAccessIterator& last,
+		      const size_t& cutoff) {
+
+      // Type synonyme pour le type des éléments du conteneur.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie
+      // ci-dessus.
+      apply(first,
+	    middle,
+	    last,
+	    std::less< const value_type& >(),
+	    cutoff);
+
+    } // apply
+
+  protected:
+
+    /**
+     * Fusion récursive en place.
+     *
+     * @param[in] first - le premier élément du premier sous-conteneur ;
+     * @param[in] middle - le premier élément du second sous-conteneur ;
+     * @param[in] last - la fin du second sous-conteneur ;
+     * @param[in] comp - la relation d'ordre ;
+     * @param[in] cutoff - la tolérance.
+     */
+    template< typename RandomAccessIterator,
+	      typename Compare >
+    static void mergeRecursive(const RandomAccessIterator& first,
+			       const RandomAccessIterator& middle,
+			       const RandomAccessIterator& last,
+			       const Compare& comp,
+			       const size_t& cutoff) {
+
+      // Taille des deux sous-conteneurs.
+      const auto size1 = middle - first;
+      const auto size2 = last - middle;
+
+      // Un sous-conteneur vide : rien à faire.
+      if (size1 == 0 || size2 == 0) {
+	return;
+      }
+
+      // Tolérance atteinte : appel direct à l'algorithme inplace_merge de la
+      // bibliothèque standard.
+      if (static_cast< size_t >(size1 + size2) < cutoff) {
+	std::inplace_merge(first, middle, last, comp);
+	return;
+      }
+
+      // Calcul des positions de coupure autour de l'élément médian du plus
+      // long des deux sous-conteneurs. Pour préserver la stabilité, les
+      // éléments du second sous-conteneur égaux au pivot restent derrière lui
+      // lorsque le pivot provient du premier, et inversement. Après rotation,
+      // le pivot occupe sa position définitive (pivot) et en est exclu des
+      // deux fusions restantes, ce qui garantit la terminaison.
+      RandomAccessIterator cut1, cut2, pivot;
+      if (size1 >= size2) {
+	cut1 = first + size1 / 2;
+	cut2 = std::lower_bound(middle, last, *cut1, comp);
+	pivot = cut1 + (cut2 - middle);
+      }
+      else {
+	const RandomAccessIterator median = middle + size2 / 2;
+	cut1 = std::upper_bound(first, middle, *median, comp);
+	cut2 = median + 1;
+	pivot = cut1 + (median - middle);
+      }
+
+      // Échange des blocs [cut1, middle) et [middle, cut2).
+      rotate(cut1, middle, cut2, cutoff);
+      const RandomAccessIterator newMiddle = cut1 + (cut2 - middle);
+
+      //Groupe de taches TBB pour gerer le parallelisme.
+      tbb::task_group groupeTache;
+
+      //Premiere tache
+      groupeTache.run([=]() {
+	  mergeRecursive(first, cut1, pivot, comp, cutoff);
+	});
+
+      //Deuxieme tache
+      groupeTache.run([=]() {
+	  mergeRecursive(pivot + 1, newMiddle + (middle - cut1), last,
+			 comp, cutoff);
+	});
+
+      // Attendre que toutes les taches soient terminees
+      groupeTache.wait();
+
+    } // mergeRecursive
+
+    /**
+     * Rotation parallèle : [first, middle) et [middle, last) sont échangés
+     * en renversant chacun des deux blocs puis leur concaténation.
+     *
+     * @param[in] first - le premier élément du premier bloc ;
+     * @param[in] middle - le premier élément du second bloc ;
+     * @param[in] last - la fin du second bloc ;
+     * @param[in] cutoff - la taille au dessous de laquelle la rotation est
+     *   effectuée via l'algorithme rotate de la bibliothèque standard.
+     */
+    template< typename RandomAccessIterator >
+    static void rotate(const RandomAccessIterator& first,
+		       const RandomAccessIterator& middle,
+		       const RandomAccessIterator& last,
+		       const size_t& cutoff) {
+      if (first == middle || middle == last) {
+	return;
+      }
+      if (static_cast< size_t >(last - first) < cutoff) {
+	std::rotate(first, middle, last);
+	return;
+      }
+      tbb::parallel_invoke([&]() { reverse(first, middle, cutoff); },
+			   [&]() { reverse(middle, last, cutoff); });
+      reverse(first, last, cutoff);
+    } // rotate
+
+    /**
+     * Renversement parallèle : les paires d'éléments symétriques sont
+     * échangées par tranches d'au moins cutoff / 2 paires.
+     *
+     * @param[in] first - le premier élément du bloc ;
+     * @param[in] last - la fin du bloc ;
+     * @param[in] cutoff - la taille au dessous de laquelle le renversement
+     *   est séquentiel.
+     */
+    template< typename RandomAccessIterator >
+    static void reverse(const RandomAccessIterator& first,
+			const RandomAccessIterator& last,
+			const size_t& cutoff) {
+      typedef typename std::iterator_traits< RandomAccessIterator >::
+	difference_type Size;
+      const Size size = last - first;
+      if (static_cast< size_t >(size) < cutoff) {
+	std::reverse(first, last);
+	return;
+      }
+      tbb::parallel_for(tbb::blocked_range< Size >(0, size / 2, cutoff / 2),
+			[&](const tbb::blocked_range< Size >& range) {
+			  for (Size i = range.begin(); i != range.end(); ++ i) {
+			    std::iter_swap(first + i, last - 1 - i);
+			  }
+			});
+    } // reverse
+
+  }; // ParallelInplaceMerge
+
+} // merging
+
+#endif
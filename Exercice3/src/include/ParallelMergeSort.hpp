@@ -0,0 +1,246 @@
+#ifndef ParallelMergeSort_hpp
+#define ParallelMergeSort_hpp
+
+#include "ParallelRecursiveMerge.hpp"
+#include "HugePageArena.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <tbb/tbb.h>
+
+namespace merging {
+
+  /**
+   * @class ParallelMergeSort ParallelMergeSort.hpp
+   *
+   * Version TBB d'un tri par fusion reposant sur ParallelRecursiveMerge.
+   *
+   * @note Les deux moitiés du conteneur sont triées récursivement par deux
+   *   tâches TBB puis fusionnées via ParallelRecursiveMerge. Un unique tampon
+   *   de la taille du conteneur est alloué au départ : à chaque niveau de la
+   *   récursion, les données passent alternativement du conteneur au tampon
+   *   et du tampon au conteneur (ping-pong), de sorte qu'aucune allocation
+   *   n'est effectuée pendant la récursion. Sous une certaine tolérance, le
+   *   tri est effectué via l'algorithme sort de la bibliothèque standard.
+   * @note Comme ParallelRecursiveMerge, ce tri n'est pas stable.
+   */
+  class ParallelMergeSort {
+  public:
+
+    /**
+     * Forme générale de l'algorithme.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du
+     *   sous-conteneur à trier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du sous-conteneur à trier ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total à respecter ;
+     * @param[in] cutoff - la taille du sous-conteneur au dessous de laquelle le
+     *   tri est effectué via l'algorithme sort de la bibliothèque standard ;
+     * @param[in] mergeCutoff - la tolérance transmise à ParallelRecursiveMerge
+     *   lors des fusions.
+     */
+    template< typename RandomAccessIterator,
+	      typename Compare >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& last,
+		      const Compare& comp,
+		      const size_t& cutoff,
+		      const size_t& mergeCutoff) {
+
+      // Type synonyme pour le type des éléments du conteneur.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Moins de deux éléments : rien à faire.
+      if (last - first < 2) {
+	return;
+      }
+
+      // L'unique tampon utilisé par toute la récursion.
+      std::vector< value_type > buffer(last - first);
+
+      // Le résultat final doit se trouver dans le conteneur d'origine.
+      sortRecursive(first,
+		    last,
+		    buffer.begin(),
+		    false,
+		    comp,
+		    std::max< size_t >(cutoff, 2),
+		    mergeCutoff);
+
+    } // apply
+
+    /**
+     * Forme générale de l'algorithme dont le tampon est puisé dans une arène
+     * à grandes pages : répété sur une même arène remise à zéro (reset)
+     * entre deux tris, il ne paie ni allocation ni défaut de page.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du
+     *   sous-conteneur à trier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du sous-conteneur à trier ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total à respecter ;
+     * @param[in] cutoff - la taille du sous-conteneur au dessous de laquelle le
+     *   tri est effectué via l'algorithme sort de la bibliothèque standard ;
+     * @param[in] mergeCutoff - la tolérance transmise à ParallelRecursiveMerge
+     *   lors des fusions ;
+     * @param[in,out] arena - l'arène fournissant le tampon.
+     */
+    template< typename RandomAccessIterator,
+	      typename Compare >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& last,
+		      const Compare& comp,
+		      const size_t& cutoff,
+		      const size_t& mergeCutoff,
+		      HugePageArena& arena) {
+
+      // Type synonyme pour le type des éléments du conteneur.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Moins de deux éléments : rien à faire.
+      if (last - first < 2) {
+	return;
+      }
+
+      // L'unique tampon utilisé par toute la récursion, puisé dans l'arène.
+      std::vector< value_type, ArenaAllocator< value_type > >
+	buffer(last - first, ArenaAllocator< value_type >(arena));
+
+      // Le résultat final doit se trouver dans le conteneur d'origine.
+      sortRecursive(first,
+		    last,
+		    buffer.begin(),
+		    false,
+		    comp,
+		    std::max< size_t >(cutoff, 2),
+		    mergeCutoff);
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total
+     * strictement inférieur à.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du
+     *   sous-conteneur à trier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du sous-conteneur à trier ;
+     * @param[in] cutoff - la taille du sous-conteneur au dessous de laquelle le
+     *   tri est effectué via l'algorithme sort de la bibliothèque standard ;
+     * @param[in] mergeCutoff - la tolérance transmise à ParallelRecursiveMerge
+     *   lors des fusions.
+     */
+    template< typename RandomAccessIterator >
+    static void apply(const RandomAccessIterator& first,
+		      const RandomAccessIterator& last,
+		      const size_t& cutoff,
+		      const size_t& mergeCutoff) {
+
+      // Type synonyme pour le type des éléments du conteneur.
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie
+      // ci-dessus.
+      apply(first,
+	    last,
+	    std::less< const value_type& >(),
+	    cutoff,
+	    mergeCutoff);
+
+    } // apply
+
+  protected:
+
+    /**
+     * Tri récursif du sous-conteneur [first, last) dont le résultat est placé
+     * soit dans le sous-conteneur lui-même, soit dans la zone correspondante
+     * du tampon.
+     *
+     * @param[in] first - un itérateur repérant le premier élément du
+     *   sous-conteneur à trier ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du sous-conteneur à trier ;
+     * @param[in] buffer - un itérateur repérant la zone du tampon associée
+     *   au sous-conteneur (de même taille) ;
+     * @param[in] intoBuffer - vrai si le résultat doit être placé dans le
+     *   tampon, faux s'il doit l'être dans le sous-conteneur ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total à respecter ;
+     * @param[in] cutoff - la taille du sous-conteneur au dessous de laquelle le
+     *   tri est effectué via l'algorithme sort de la bibliothèque standard ;
+     * @param[in] mergeCutoff - la tolérance transmise à ParallelRecursiveMerge
+     *   lors des fusions.
+     */
+    template< typename RandomAccessIterator,
+	      typename BufferIterator,
+	      typename Compare >
+    static void sortRecursive(const RandomAccessIterator& first,
+			      const RandomAccessIterator& last,
+			      const BufferIterator& buffer,
+			      const bool& intoBuffer,
+			      const Compare& comp,
+			      const size_t& cutoff,
+			      const size_t& mergeCutoff) {
+
+      // Taille du sous-conteneur.
+      const auto size = last - first;
+
+      // Tolérance atteinte : appel direct à std::sort puis, si nécessaire,
+      // déplacement du résultat vers le tampon.
+      if (static_cast< size_t >(size) < cutoff) {
+	std::sort(first, last, comp);
+	if (intoBuffer) {
+	  std::move(first, last, buffer);
+	}
+	return;
+      }
+
+      // Calcul de la position médiane.
+      const auto half = size / 2;
+      const RandomAccessIterator middle = first + half;
+      const BufferIterator bufferMiddle = buffer + half;
+      const BufferIterator bufferLast = buffer + size;
+
+      // Les deux moitiés sont triées vers l'autre zone que celle qui doit
+      // accueillir le résultat.
+      tbb::task_group groupeTache;
+      groupeTache.run([=]() {
+	sortRecursive(first, middle, buffer, ! intoBuffer, comp,
+		      cutoff, mergeCutoff);
+      });
+      groupeTache.run([=]() {
+	sortRecursive(middle, last, bufferMiddle, ! intoBuffer, comp,
+		      cutoff, mergeCutoff);
+      });
+      groupeTache.wait();
+
+      // Fusion des deux moitiés vers la zone cible.
+      if (intoBuffer) {
+	ParallelRecursiveMerge::apply(first, middle,
+				      middle, last,
+				      buffer,
+				      comp,
+				      mergeCutoff);
+      }
+      else {
+	ParallelRecursiveMerge::apply(buffer, bufferMiddle,
+				      bufferMiddle, bufferLast,
+				      first,
+				      comp,
+				      mergeCutoff);
+      }
+
+    } // sortRecursive
+
+  }; // ParallelMergeSort
+
+} // merging
+
+#endif
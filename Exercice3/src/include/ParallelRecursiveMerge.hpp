@@ -1,8 +1,14 @@
 #ifndef ParallelRecursiveMerge_hpp
 #define ParallelRecursiveMerge_hpp
 
+#include "MergeKernel.hpp"
+#include "GallopingKernel.hpp"
+#include "KeyMergeKernel.hpp"
+#include "CutoffCache.hpp"
 #include <functional>
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <tbb/tbb.h>
 #include <iostream>
 #include <sstream>
@@ -19,7 +25,23 @@ namespace merging {
    *   Stein, "Introduction to Algorithms", 3rd ed., 2009, pp 798-802. La 
    *   récursion est interrompue lorsque la somme des tailles des deux 
    *   sous-conteneurs à fusionner passe sous une certaine tolérance. La fusion 
-   *   est alors effectuée via l'algorithme merge de la bibliothèque standard.
+   *   est alors effectuée via MergeKernel (vectorisé lorsque c'est possible,
+   *   sinon l'algorithme merge de la bibliothèque standard).
+   * @note Le noyau de fusion séquentielle est une politique : le premier
+   *   paramètre template (Leaf, MergeKernel par défaut) désigne toute classe
+   *   offrant la méthode statique apply de MergeKernel, par exemple
+   *   GallopingKernel pour des entrées formées de longs blocs disjoints :
+   *   ParallelRecursiveMerge::apply< GallopingKernel >(...).
+   * @note applyMergePath coupe le conteneur cible en deux moitiés égales à
+   *   chaque niveau (chemin de fusion) au lieu de couper le plus long des
+   *   sous-conteneurs en son milieu : les tâches restent équilibrées sur des
+   *   entrées riches en doublons ou de tailles très différentes.
+   * @note applyLimited borne la profondeur de la récursion selon le nombre
+   *   de threads (quelques tâches par thread) au lieu de la seule tolérance,
+   *   et réutilise un unique groupe de tâches.
+   * @note applyByKey fusionne des enregistrements rangés en colonnes : seules
+   *   les clés sont fusionnées, avec la permutation des enregistrements, puis
+   *   gather rassemble chaque colonne de charge utile (voir KeyMergeKernel).
    */
   class ParallelRecursiveMerge {
   public:
@@ -45,7 +67,8 @@ namespace merging {
      * @return un itérateur repérant la fin de la zone de fusion dans le
      *   conteneur cible.
      */
-    template< typename InputRandomAccessIterator1,
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator,
 	      typename Compare >
@@ -59,7 +82,7 @@ namespace merging {
 	  const size_t& cutoff) {
 
       // Invocation de la stratégie adéquate.
-      strategyTasking(first1, 
+      strategyTasking< Leaf >(first1, 
 		  last1, 
 		  first2, 
 		  last2, 
@@ -94,7 +117,8 @@ namespace merging {
      * @return un itérateur repérant la fin de la zone de fusion dans le
      *   conteneur cible.
      */
-    template< typename InputRandomAccessIterator1,
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator >
     static OutputRandomAccessIterator
@@ -113,7 +137,7 @@ namespace merging {
 
       // Fabriquer le comparateur less puis invoquer la méthode définie 
       // ci-dessus.
-      return apply(first1, 
+      return apply< Leaf >(first1, 
 		   last1,
 		   first2,
 		   last2,
@@ -123,8 +147,919 @@ namespace merging {
       
     } // apply
 
+    /**
+     * Forme générale de l'algorithme employant la tolérance calibrée sur la
+     * machine courante pour la taille des éléments et le nombre de threads
+     * disponibles (voir CutoffCache).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     *
+     * @note Cette surcharge est écartée lorsque le dernier argument est un
+     *   entier, qui désigne alors la tolérance de la forme spécifique.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare,
+	      typename = typename std::enable_if<
+		! std::is_integral< Compare >::value >::type >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Recherche de la tolérance calibrée puis invocation de la forme
+      // générale.
+      const size_t cutoff =
+	CutoffCache::lookup(sizeof(value_type),
+			    tbb::this_task_arena::max_concurrency());
+      return apply< Leaf >(first1,
+		   last1,
+		   first2,
+		   last2,
+		   result,
+		   comp,
+		   cutoff);
+
+    } // apply
+
+    /**
+     * Forme spécifique de l'algorithme pour la relation d'ordre total 
+     * strictement inférieur à, employant la tolérance calibrée sur la machine
+     * courante (voir CutoffCache).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie 
+      // ci-dessus.
+      return apply< Leaf >(first1,
+		   last1,
+		   first2,
+		   last2,
+		   result,
+		   std::less< const value_type& >());
+
+    } // apply
+
+    /**
+     * Forme générale de l'algorithme déplaçant (au lieu de recopier) les
+     * éléments des deux sous-conteneurs vers le conteneur cible. Les
+     * sous-conteneurs sources sont consommés : leurs éléments sont laissés
+     * dans un état valide mais non spécifié.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée séquentiellement.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     *
+     * @note La stratégie est la même que celle d'apply : les itérateurs
+     *   sources sont simplement enveloppés dans des std::move_iterator, de
+     *   sorte que la recopie de l'élément médian et les fusions des feuilles
+     *   deviennent des déplacements. Les recherches dichotomiques ne font que
+     *   lire les éléments.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      const size_t& cutoff) {
+
+      // Invocation de la stratégie adéquate sur des itérateurs de
+      // déplacement.
+      strategyTasking(std::make_move_iterator(first1),
+		      std::make_move_iterator(last1),
+		      std::make_move_iterator(first2),
+		      std::make_move_iterator(last2),
+		      result,
+		      comp,
+		      cutoff);
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // applyMove
+
+    /**
+     * Forme spécifique de l'algorithme déplaçant les éléments pour la
+     * relation d'ordre total strictement inférieur à.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée séquentiellement.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const size_t& cutoff) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie 
+      // ci-dessus.
+      return applyMove(first1,
+		       last1,
+		       first2,
+		       last2,
+		       result,
+		       std::less< const value_type& >(),
+		       cutoff);
+
+    } // applyMove
+
+    /**
+     * Forme générale de l'algorithme dont les deux appels récursifs sont
+     * lancés via tbb::parallel_invoke (stratégie de l'Exercice2) au lieu
+     * d'un tbb::task_group.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée via le noyau Leaf.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyInvoke(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& result,
+		const Compare& comp,
+		const size_t& cutoff) {
+
+      strategyInvokeRecursive< Leaf >(first1, 
+				      last1, 
+				      first2, 
+				      last2, 
+				      result, 
+				      comp, 
+				      cutoff);
+      
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // applyInvoke
+
+    /**
+     * Forme générale de l'algorithme dont chaque niveau de récursion coupe
+     * le conteneur cible en son milieu (chemin de fusion, ou merge path) au
+     * lieu de couper le plus long des deux sous-conteneurs : la coupe est
+     * trouvée par recherche dichotomique sur la diagonale correspondante et
+     * chacune des deux tâches produit exactement la moitié du résultat,
+     * quelles que soient la répartition des valeurs (doublons) et les
+     * tailles relatives (asymétrie) des sous-conteneurs. La profondeur de la
+     * récursion est ainsi log2((m + n) / cutoff).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée via le noyau Leaf.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     *
+     * @note Les sous-conteneurs ne sont jamais échangés : la fusion est
+     *   stable (à valeurs égales, les éléments du premier précèdent ceux du
+     *   second).
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyMergePath(const InputRandomAccessIterator1& first1,
+		   const InputRandomAccessIterator1& last1,
+		   const InputRandomAccessIterator2& first2,
+		   const InputRandomAccessIterator2& last2,
+		   const OutputRandomAccessIterator& result,
+		   const Compare& comp,
+		   const size_t& cutoff) {
+
+      strategyMergePath< Leaf >(first1, 
+				last1, 
+				first2, 
+				last2, 
+				result, 
+				comp, 
+				std::max< size_t >(cutoff, 2));
+      
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // applyMergePath
+
+    /**
+     * Forme de l'algorithme à coupe par chemin de fusion pour la relation
+     * d'ordre total strictement inférieur.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée via le noyau Leaf.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    applyMergePath(const InputRandomAccessIterator1& first1,
+		   const InputRandomAccessIterator1& last1,
+		   const InputRandomAccessIterator2& first2,
+		   const InputRandomAccessIterator2& last2,
+		   const OutputRandomAccessIterator& result,
+		   const size_t& cutoff) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      return applyMergePath< Leaf >(first1,
+				    last1,
+				    first2,
+				    last2,
+				    result,
+				    std::less< const value_type& >(),
+				    cutoff);
+
+    } // applyMergePath
+
+    /**
+     * Forme générale de l'algorithme dont le nombre de tâches est limité par
+     * le parallélisme disponible et non plus seulement par la tolérance : la
+     * récursion (coupe par chemin de fusion, voir applyMergePath) s'arrête
+     * après ceil(log2(P * tasksPerThread)) niveaux, P étant le nombre de
+     * threads de l'arène courante, ce qui produit environ tasksPerThread
+     * tâches de même taille par thread pour le vol de tâches ; chaque tâche
+     * est ensuite fusionnée séquentiellement par le noyau Leaf. Un seul
+     * tbb::task_group est employé pour toute la fusion, et chaque niveau ne
+     * lance qu'une tâche (la seconde moitié est traitée sur place).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la récursion s'arrête de toute façon ;
+     * @param[in] tasksPerThread - le nombre de tâches visé par thread.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyLimited(const InputRandomAccessIterator1& first1,
+		 const InputRandomAccessIterator1& last1,
+		 const InputRandomAccessIterator2& first2,
+		 const InputRandomAccessIterator2& last2,
+		 const OutputRandomAccessIterator& result,
+		 const Compare& comp,
+		 const size_t& cutoff,
+		 const size_t& tasksPerThread = 4) {
+
+      // Profondeur : plus petit d tel que 2^d >= P * tasksPerThread.
+      const size_t tasks =
+	static_cast< size_t >(tbb::this_task_arena::max_concurrency()) *
+	std::max< size_t >(tasksPerThread, 1);
+      unsigned depth = 0;
+      while ((size_t(1) << depth) < tasks) {
+	depth ++;
+      }
+
+      tbb::task_group groupeTache;
+      strategyLimited< Leaf >(first1, last1, first2, last2, result, comp,
+			      std::max< size_t >(cutoff, 2), depth,
+			      groupeTache);
+      groupeTache.wait();
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + (last1 - first1) + (last2 - first2);
+
+    } // applyLimited
+
+    /**
+     * Fusion parallèle par clé (structure de tableaux, voir KeyMergeKernel) :
+     * les clés des deux sous-conteneurs sont fusionnées et la permutation des
+     * enregistrements est produite simultanément, selon la récursion
+     * d'apply.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second sous-conteneur ;
+     * @param[out] keys - un itérateur repérant la position où recopier la
+     *   première clé fusionnée ;
+     * @param[out] permutation - un itérateur repérant la position où écrire
+     *   le numéro (de 0 à m + n - 1) de l'enregistrement de la première clé
+     *   fusionnée ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les clés projetées ;
+     * @param[in] projection - la projection appliquée aux clés avant
+     *   comparaison ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement.
+     *
+     * @note À clés égales, l'enregistrement du premier sous-conteneur
+     *   précède celui du second : la récursion découpe le plus long des deux
+     *   sans les échanger.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename KeyRandomAccessIterator,
+	      typename IndexRandomAccessIterator,
+	      typename Compare,
+	      typename Projection >
+    static void
+    applyByKey(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const KeyRandomAccessIterator& keys,
+	       const IndexRandomAccessIterator& permutation,
+	       const Compare& comp,
+	       const Projection& projection,
+	       const size_t& cutoff) {
+
+      typedef std::iterator_traits< IndexRandomAccessIterator > Traits;
+      typedef typename Traits::value_type Index;
+
+      strategyByKey(first1, last1, Index(0),
+		    first2, last2, static_cast< Index >(last1 - first1),
+		    keys, permutation, comp, projection, cutoff);
+
+    } // applyByKey
+
+    /**
+     * Fusion parallèle par clé sans projection.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second sous-conteneur ;
+     * @param[out] keys - un itérateur repérant la position où recopier la
+     *   première clé fusionnée ;
+     * @param[out] permutation - un itérateur repérant la position où écrire
+     *   le numéro de l'enregistrement de la première clé fusionnée ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les clés ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename KeyRandomAccessIterator,
+	      typename IndexRandomAccessIterator,
+	      typename Compare >
+    static void
+    applyByKey(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const KeyRandomAccessIterator& keys,
+	       const IndexRandomAccessIterator& permutation,
+	       const Compare& comp,
+	       const size_t& cutoff) {
+
+      applyByKey(first1, last1, first2, last2, keys, permutation, comp,
+		 KeyMergeKernel::Identity(), cutoff);
+
+    } // applyByKey
+
+    /**
+     * Rassemble en parallèle une colonne de charge utile selon la
+     * permutation produite par applyByKey.
+     *
+     * @param[in] first - un itérateur repérant le premier numéro de la
+     *   permutation ;
+     * @param[in] last - un itérateur repérant la position située juste
+     *   derrière le dernier numéro de la permutation ;
+     * @param[in] m - le nombre d'enregistrements du premier sous-conteneur ;
+     * @param[in] column1 - un itérateur repérant la colonne du premier
+     *   sous-conteneur ;
+     * @param[in] column2 - un itérateur repérant la colonne du second
+     *   sous-conteneur ;
+     * @param[out] result - un itérateur repérant la position où recopier la
+     *   première valeur rassemblée ;
+     * @param[in] cutoff - le nombre d'éléments au dessous duquel un bloc est
+     *   rassemblé séquentiellement.
+     */
+    template< typename IndexRandomAccessIterator,
+	      typename ColumnRandomAccessIterator1,
+	      typename ColumnRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static void
+    gather(const IndexRandomAccessIterator& first,
+	   const IndexRandomAccessIterator& last,
+	   const size_t& m,
+	   const ColumnRandomAccessIterator1& column1,
+	   const ColumnRandomAccessIterator2& column2,
+	   const OutputRandomAccessIterator& result,
+	   const size_t& cutoff) {
+
+      typedef std::iterator_traits< IndexRandomAccessIterator > Traits;
+      typedef typename Traits::value_type Index;
+
+      tbb::parallel_for(
+	tbb::blocked_range< size_t >(0, last - first,
+				     std::max< size_t >(cutoff, 1)),
+	[&](const tbb::blocked_range< size_t >& range) {
+	  KeyMergeKernel::gather(first + range.begin(), first + range.end(),
+				 static_cast< Index >(m),
+				 column1, column2,
+				 result + range.begin());
+	});
+
+    } // gather
+
   protected:
 
+    /**
+     * Récursion de applyByKey : le plus long des deux sous-conteneurs est
+     * coupé en son milieu, la position correspondante dans l'autre est
+     * obtenue par recherche dichotomique, puis les deux moitiés sont
+     * fusionnées par deux tâches.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier sous-conteneur ;
+     * @param[in] base1 - le numéro de l'enregistrement de first1 ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second sous-conteneur ;
+     * @param[in] base2 - le numéro de l'enregistrement de first2 ;
+     * @param[out] keys - un itérateur repérant la position où recopier la
+     *   première clé fusionnée ;
+     * @param[out] permutation - un itérateur repérant la position où écrire
+     *   le numéro de l'enregistrement de la première clé fusionnée ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les clés projetées ;
+     * @param[in] projection - la projection appliquée aux clés ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au
+     *   dessous de laquelle la fusion est effectuée séquentiellement.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename KeyRandomAccessIterator,
+	      typename IndexRandomAccessIterator,
+	      typename Index,
+	      typename Compare,
+	      typename Projection >
+    static void
+    strategyByKey(const InputRandomAccessIterator1& first1,
+		  const InputRandomAccessIterator1& last1,
+		  const Index& base1,
+		  const InputRandomAccessIterator2& first2,
+		  const InputRandomAccessIterator2& last2,
+		  const Index& base2,
+		  const KeyRandomAccessIterator& keys,
+		  const IndexRandomAccessIterator& permutation,
+		  const Compare& comp,
+		  const Projection& projection,
+		  const size_t& cutoff) {
+
+      // Taille des deux sous-conteneurs.
+      const auto size1 = last1 - first1;
+      const auto size2 = last2 - first2;
+
+      // Tolérance atteinte : fusion séquentielle, le premier sous-conteneur
+      // précédant le second à clés égales.
+      if (static_cast< size_t >(size1 + size2) < cutoff || size1 == 0 ||
+	  size2 == 0) {
+	KeyMergeKernel::apply(first1, last1, base1, first2, last2, base2,
+			      keys, permutation,
+			      [&](const auto& a, const auto& b) {
+				return ! comp(b, a);
+			      },
+			      projection);
+	return;
+      }
+
+      // Coupe du plus long : les clés égales à la clé médiane restent du
+      // côté qui préserve la priorité du premier sous-conteneur.
+      auto middle1 = first1;
+      auto middle2 = first2;
+      bool pivot1 = size1 >= size2;
+      if (pivot1) {
+	middle1 = first1 + size1 / 2;
+	middle2 = std::lower_bound(first2, last2, *middle1,
+				   [&](const auto& x, const auto& y) {
+				     return comp(projection(x), projection(y));
+				   });
+      }
+      else {
+	middle2 = first2 + size2 / 2;
+	middle1 = std::upper_bound(first1, last1, *middle2,
+				   [&](const auto& x, const auto& y) {
+				     return comp(projection(x), projection(y));
+				   });
+      }
+      const auto offset = (middle1 - first1) + (middle2 - first2);
+
+      // Recopie de la clé médiane et de son numéro.
+      if (pivot1) {
+	keys[offset] = *middle1;
+	permutation[offset] = static_cast< Index >(base1 + (middle1 - first1));
+      }
+      else {
+	keys[offset] = *middle2;
+	permutation[offset] = static_cast< Index >(base2 + (middle2 - first2));
+      }
+      const auto next1 = pivot1 ? middle1 + 1 : middle1;
+      const auto next2 = pivot1 ? middle2 : middle2 + 1;
+
+      tbb::task_group groupeTache;
+      groupeTache.run([=, &comp, &projection]() {
+	  strategyByKey(first1, middle1, base1, first2, middle2, base2,
+			keys, permutation, comp, projection, cutoff);
+	});
+      groupeTache.run([=, &comp, &projection]() {
+	  strategyByKey(next1, last1,
+			static_cast< Index >(base1 + (next1 - first1)),
+			next2, last2,
+			static_cast< Index >(base2 + (next2 - first2)),
+			keys + offset + 1, permutation + offset + 1,
+			comp, projection, cutoff);
+	});
+      groupeTache.wait();
+
+    } // strategyByKey
+
+
+    /**
+     * Implementation de tbb_invoke sur un merge de maniere recursive.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée via le noyau Leaf.
+     */
+    template< typename Leaf,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void strategyInvokeRecursive(const InputRandomAccessIterator1& first1,
+					const InputRandomAccessIterator1& last1,
+					const InputRandomAccessIterator2& first2,
+					const InputRandomAccessIterator2& last2,
+					const OutputRandomAccessIterator& result,
+					const Compare& comp,
+					const size_t& cutoff) {
+      // Taille des deux sous-conteneurs.
+      const auto size1 = last1 - first1;
+      const auto size2 = last2 - first2;
+
+      // Tolérance atteinte : appel direct au noyau de fusion séquentielle.
+      if (static_cast<size_t>(size1 + size2) < cutoff) {
+	Leaf::apply(first1, last1, first2, last2, result, comp);
+	return;
+      }
+
+      // Le sous-conteneur gauche est supposé être plus long.
+      if (size1 < size2) {
+	strategyInvokeRecursive< Leaf >(first2, last2, first1, last1, result,
+					comp, cutoff);
+	return;
+      }
+
+      // Calcul des positions médianes.
+      const InputRandomAccessIterator1 middle1 =
+	first1 + size1 / 2;
+      const InputRandomAccessIterator2 middle2 =
+	std::lower_bound(first2, last2, *middle1, comp);
+      const OutputRandomAccessIterator middle3 =
+	result + (middle1 - first1) + (middle2 - first2);
+
+      // Recopie de l'élément médian du sous-conteneur gauche dans le 
+      // sous-conteneur résultat.
+      *middle3 = *middle1;
+
+      tbb::parallel_invoke(
+        [&]() {
+	  strategyInvokeRecursive< Leaf >(first1, middle1, first2, middle2,
+					  result, comp, cutoff);
+        },
+        [&]() {
+	  strategyInvokeRecursive< Leaf >(middle1 + 1, last1, middle2, last2,
+					  middle3 + 1, comp, cutoff);
+        }
+      );
+    } // strategyInvokeRecursive
+
+    /**
+     * Récursion à coupe par chemin de fusion (voir applyMergePath).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la fusion est effectuée via le noyau Leaf (au
+     *   moins 2).
+     */
+    template< typename Leaf,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void strategyMergePath(const InputRandomAccessIterator1& first1,
+				  const InputRandomAccessIterator1& last1,
+				  const InputRandomAccessIterator2& first2,
+				  const InputRandomAccessIterator2& last2,
+				  const OutputRandomAccessIterator& result,
+				  const Compare& comp,
+				  const size_t& cutoff) {
+      // Taille des deux sous-conteneurs.
+      const auto size1 = last1 - first1;
+      const auto size2 = last2 - first2;
+
+      // Tolérance atteinte : appel direct au noyau de fusion séquentielle.
+      if (static_cast< size_t >(size1 + size2) < cutoff) {
+	Leaf::apply(first1, last1, first2, last2, result, comp);
+	return;
+      }
+
+      // Diagonale du milieu du conteneur cible.
+      const auto half = (size1 + size2) / 2;
+      const auto j = diagonal(first1, size1, first2, size2, half, comp);
+      const InputRandomAccessIterator1 middle1 = first1 + j;
+      const InputRandomAccessIterator2 middle2 = first2 + (half - j);
+
+      // Deux tâches produisant chacune la moitié du résultat.
+      tbb::task_group groupeTache;
+      groupeTache.run([=]() {
+	  strategyMergePath< Leaf >(first1, middle1, first2, middle2, result,
+				    comp, cutoff);
+	});
+      groupeTache.run_and_wait([=]() {
+	  strategyMergePath< Leaf >(middle1, last1, middle2, last2,
+				    result + half, comp, cutoff);
+	});
+    } // strategyMergePath
+
+    /**
+     * Recherche dichotomique sur une diagonale du chemin de fusion : retourne
+     * le nombre j d'éléments du premier sous-conteneur parmi les i premiers
+     * éléments du résultat (les i - j autres venant du second), soit le plus
+     * petit rang j tel que first2[i - j - 1] < first1[j]. À valeurs égales,
+     * le premier sous-conteneur passe en premier.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] size1 - le nombre d'éléments du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] size2 - le nombre d'éléments du second sous-conteneur ;
+     * @param[in] i - le rang de la diagonale, entre 0 et size1 + size2 ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return le rang j dans le premier sous-conteneur.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputSize1,
+	      typename InputRandomAccessIterator2,
+	      typename InputSize2,
+	      typename OutputSize,
+	      typename Compare >
+    static InputSize1 diagonal(const InputRandomAccessIterator1& first1,
+			       const InputSize1& size1,
+			       const InputRandomAccessIterator2& first2,
+			       const InputSize2& size2,
+			       const OutputSize& i,
+			       const Compare& comp) {
+      InputSize1 low = i > size2 ? i - size2 : 0;
+      InputSize1 high = std::min< InputSize1 >(i, size1);
+      while (low < high) {
+	const InputSize1 middle = low + (high - low) / 2;
+	if (comp(first2[i - middle - 1], first1[middle])) {
+	  high = middle;
+	}
+	else {
+	  low = middle + 1;
+	}
+      }
+      return low;
+    } // diagonal
+
+    /**
+     * Récursion à profondeur limitée (voir applyLimited) : tant que la
+     * profondeur le permet, la première moitié du résultat est confiée à une
+     * nouvelle tâche du groupe et la seconde est traitée sur place ; le
+     * reste est fusionné par le noyau Leaf.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] cutoff - la somme des tailles des deux sous-conteneurs au 
+     *   dessous de laquelle la récursion s'arrête (au moins 2) ;
+     * @param[in] depth - le nombre de niveaux de récursion restants ;
+     * @param[in,out] group - le groupe de tâches, unique pour toute la fusion.
+     */
+    template< typename Leaf,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void strategyLimited(InputRandomAccessIterator1 first1,
+				const InputRandomAccessIterator1& last1,
+				InputRandomAccessIterator2 first2,
+				const InputRandomAccessIterator2& last2,
+				OutputRandomAccessIterator result,
+				const Compare& comp,
+				const size_t& cutoff,
+				unsigned depth,
+				tbb::task_group& group) {
+      for (; depth != 0; depth --) {
+	const auto size1 = last1 - first1;
+	const auto size2 = last2 - first2;
+	if (static_cast< size_t >(size1 + size2) < cutoff) {
+	  break;
+	}
+
+	// Diagonale du milieu : première moitié confiée au groupe, seconde
+	// moitié traitée par l'itération suivante.
+	const auto half = (size1 + size2) / 2;
+	const auto j = diagonal(first1, size1, first2, size2, half, comp);
+	const InputRandomAccessIterator1 middle1 = first1 + j;
+	const InputRandomAccessIterator2 middle2 = first2 + (half - j);
+	group.run([=, &group]() {
+	    strategyLimited< Leaf >(first1, middle1, first2, middle2, result,
+				    comp, cutoff, depth - 1, group);
+	  });
+	first1 = middle1;
+	first2 = middle2;
+	result += half;
+      }
+      Leaf::apply(first1, last1, first2, last2, result, comp);
+    } // strategyLimited
+
 
     /**
      * Implementation de base et appel en recursion ensuite pour la stategie B
@@ -145,7 +1080,8 @@ namespace merging {
      *   dessous de laquelle la fusion est effectuée via l'algorithme merge de 
      *   la bibliothèque standard.
      */
-    template< typename InputRandomAccessIterator1,
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator,
 	      typename Compare >
@@ -157,7 +1093,7 @@ namespace merging {
 			  const Compare& comp,
 			  const size_t& cutoff) {
 
-      strategyTaskingRecursive(first1,last1,first2,last2,result,comp,cutoff);
+      strategyTaskingRecursive< Leaf >(first1,last1,first2,last2,result,comp,cutoff);
 
 
     } // strategyB
@@ -181,7 +1117,8 @@ namespace merging {
      *   dessous de laquelle la fusion est effectuée via l'algorithme merge de 
      *   la bibliothèque standard.
      */    
-template< typename InputRandomAccessIterator1,
+template< typename Leaf,
+          typename InputRandomAccessIterator1,
           typename InputRandomAccessIterator2,
           typename OutputRandomAccessIterator,
           typename Compare >
@@ -196,9 +1133,9 @@ static void strategyTaskingRecursive(const InputRandomAccessIterator1& first1,
     const auto size1 = last1 - first1;
     const auto size2 = last2 - first2;
 
-    // Tolérance atteinte : appel direct à std::merge.
+    // Tolérance atteinte : appel direct au noyau de fusion séquentielle.
     if (static_cast<size_t>(size1 + size2) < cutoff) {
-        std::merge(first1, last1, first2, last2, result, comp);
+        Leaf::apply(first1, last1, first2, last2, result, comp);
         return;
     }
 
@@ -206,7 +1143,7 @@ static void strategyTaskingRecursive(const InputRandomAccessIterator1& first1,
 
     // Le sous-conteneur gauche est supposé être plus long.
     if (size1 < size2) {
-        strategyTaskingRecursive(first2, last2, first1, last1, result, comp, cutoff);
+        strategyTaskingRecursive< Leaf >(first2, last2, first1, last1, result, comp, cutoff);
         return;
     }
 
@@ -227,12 +1164,12 @@ static void strategyTaskingRecursive(const InputRandomAccessIterator1& first1,
 
     //Premiere tache
     groupeTache.run([=]() {
-        strategyTaskingRecursive(first1, middle1, first2, middle2, result, comp, cutoff);
+        strategyTaskingRecursive< Leaf >(first1, middle1, first2, middle2, result, comp, cutoff);
     });
 
     //Deuxieme tache
     groupeTache.run([=]() {
-        strategyTaskingRecursive(middle1 + 1, last1, middle2, last2, middle3 + 1, comp, cutoff);
+        strategyTaskingRecursive< Leaf >(middle1 + 1, last1, middle2, last2, middle3 + 1, comp, cutoff);
     });
 
     // Attendre que toutes les taches soient terminees
@@ -0,0 +1,305 @@
+#ifndef StreamingMerge_hpp
+#define StreamingMerge_hpp
+
+#include "ParallelRecursiveMerge.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <tbb/concurrent_queue.h>
+#include <tbb/parallel_pipeline.h>
+
+namespace merging {
+
+  /**
+   * @class StreamingMerge StreamingMerge.hpp
+   *
+   * Fusion de deux flots triés reçus par blocs : les producteurs déposent
+   * leurs blocs (push) dans deux files bornées, puis signalent la fin de leur
+   * flot (close) ; run fusionne les blocs au fil de leur arrivée et remet les
+   * blocs fusionnés, dans l'ordre, à un consommateur.
+   *
+   * @note run exécute un tbb::parallel_pipeline à trois étages :
+   *   - décision (série) : compare les derniers éléments reçus de chaque flot
+   *     et détache des éléments en attente le plus long préfixe sûr, c'est à
+   *     dire dont aucun élément à venir ne pourra s'intercaler ;
+   *   - fusion (parallèle) : fusionne les deux parties du préfixe via
+   *     ParallelRecursiveMerge ;
+   *   - écriture (série, dans l'ordre) : remet le bloc fusionné au
+   *     consommateur et relève sa latence, écart entre l'arrivée du plus
+   *     ancien élément du bloc et la fin de son écriture.
+   *   La réception des blocs, leur fusion et leur écriture se recouvrent
+   *   donc ; le nombre de blocs en vol est borné par le paramètre tokens.
+   * @note Si lastA et lastB sont les derniers éléments reçus des flots A et
+   *   B, le préfixe sûr comprend, lorsque comp(lastB, lastA), tout B et les
+   *   éléments de A qui ne sont pas supérieurs à lastB ; sinon, tout A et les
+   *   éléments de B strictement inférieurs à lastA (à égalité, A précède B).
+   *   L'un des deux flots en attente est ainsi toujours épuisé, puis
+   *   réalimenté par sa file. Un flot clos ne contraint plus l'autre.
+   * @note comp doit être une relation d'ordre strict (std::less par
+   *   défaut).
+   * @note L'étage de décision attend les blocs en bloquant sur les files :
+   *   chaque flot doit être alimenté par son propre producteur, faute de quoi
+   *   un producteur bloqué sur une file pleine pourrait attendre un pipeline
+   *   qui attend l'autre file.
+   */
+  template< typename T, typename Compare = std::less< const T& > >
+  class StreamingMerge {
+  public:
+
+    /** Type synonyme : un bloc d'éléments triés. */
+    typedef std::vector< T > Chunk;
+
+    /** Type synonyme : l'horloge des latences. */
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Bilan d'une fusion.
+     */
+    struct Statistics {
+      size_t chunks;                   /** Nombre de blocs écrits. */
+      size_t elements;                 /** Nombre d'éléments écrits. */
+      std::vector< double > latencies; /** Latence de chaque bloc (msec). */
+    };
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] capacity - le nombre maximal de blocs en attente dans
+     *   chaque file ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les flots.
+     */
+    explicit StreamingMerge(const size_t& capacity,
+			    const Compare& comp = Compare())
+      : comp(comp) {
+      for (auto& queue : queues) {
+	queue.set_capacity(std::max< size_t >(capacity, 1));
+      }
+    }
+
+    StreamingMerge(const StreamingMerge&) = delete;
+    StreamingMerge& operator=(const StreamingMerge&) = delete;
+
+    /**
+     * Dépose un bloc dans la file d'un flot, en attendant si elle est pleine.
+     * Les éléments du bloc doivent être triés et ne pas précéder ceux des
+     * blocs précédents du même flot.
+     *
+     * @param[in] side - le flot (0 pour A, 1 pour B) ;
+     * @param[in] chunk - le bloc, consommé.
+     */
+    void push(const size_t& side, Chunk&& chunk) {
+      if (! chunk.empty()) {
+	queues[side].push(Arrival{ std::move(chunk), Clock::now() });
+      }
+    }
+
+    /**
+     * Signale la fin d'un flot.
+     *
+     * @param[in] side - le flot (0 pour A, 1 pour B).
+     */
+    void close(const size_t& side) {
+      queues[side].push(Arrival{ Chunk(), Clock::now() });
+    }
+
+    /**
+     * Fusionne les deux flots jusqu'à leur fin.
+     *
+     * @param[in] sink - le consommateur, invoqué dans l'ordre sur chaque
+     *   bloc fusionné (const Chunk&) ;
+     * @param[in] tokens - le nombre maximal de blocs en vol dans le
+     *   pipeline ;
+     * @param[in] cutoff - la tolérance de ParallelRecursiveMerge.
+     * @return le bilan de la fusion.
+     */
+    template< typename Sink >
+    Statistics run(const Sink& sink, const size_t& tokens,
+		   const size_t& cutoff) {
+      Pending pending[2];
+      bool open[2] = { true, true };
+      Statistics statistics{ 0, 0, std::vector< double >() };
+
+      tbb::parallel_pipeline(
+	std::max< size_t >(tokens, 1),
+
+	// Décision : détacher le plus long préfixe sûr.
+	tbb::make_filter< void, Batch >(
+	  tbb::filter_mode::serial_in_order,
+	  [&](tbb::flow_control& control) -> Batch {
+	    for (size_t side = 0; side != 2; side ++) {
+	      if (open[side] && pending[side].empty()) {
+		refill(side, pending[side], open[side]);
+	      }
+	    }
+	    if (pending[0].empty() && pending[1].empty()) {
+	      control.stop();
+	      return Batch();
+	    }
+
+	    // Nombre d'éléments sûrs de chaque flot : un flot ouvert a
+	    // toujours des éléments en attente et contraint l'autre.
+	    size_t safe[2] = { pending[0].size(), pending[1].size() };
+	    if (open[1]) {
+	      safe[0] = std::upper_bound(pending[0].begin(),
+					 pending[0].data.cend(),
+					 pending[1].data.back(), comp) -
+		pending[0].begin();
+	    }
+	    if (open[0]) {
+	      safe[1] = std::lower_bound(pending[1].begin(),
+					 pending[1].data.cend(),
+					 pending[0].data.back(), comp) -
+		pending[1].begin();
+	    }
+
+	    Batch batch;
+	    batch.arrival = Clock::time_point::max();
+	    for (size_t side = 0; side != 2; side ++) {
+	      if (safe[side] != 0) {
+		batch.arrival = std::min(batch.arrival,
+					 pending[side].arrival);
+		batch.parts[side] = pending[side].take(safe[side]);
+	      }
+	    }
+	    return batch;
+	  }) &
+
+	// Fusion parallèle des deux parties.
+	tbb::make_filter< Batch, Merged >(
+	  tbb::filter_mode::parallel,
+	  [&](const Batch& batch) -> Merged {
+	    Merged merged;
+	    merged.arrival = batch.arrival;
+	    merged.data.resize(batch.parts[0].size() + batch.parts[1].size());
+	    ParallelRecursiveMerge::apply(batch.parts[0].begin(),
+					  batch.parts[0].end(),
+					  batch.parts[1].begin(),
+					  batch.parts[1].end(),
+					  merged.data.begin(),
+					  comp,
+					  cutoff);
+	    return merged;
+	  }) &
+
+	// Écriture dans l'ordre et relevé de la latence.
+	tbb::make_filter< Merged, void >(
+	  tbb::filter_mode::serial_in_order,
+	  [&](const Merged& merged) {
+	    if (merged.data.empty()) {
+	      return;
+	    }
+	    sink(merged.data);
+	    statistics.chunks ++;
+	    statistics.elements += merged.data.size();
+	    statistics.latencies.push_back(
+	      std::chrono::duration< double, std::milli >(
+		Clock::now() - merged.arrival).count());
+	  }));
+
+      return statistics;
+    } // run
+
+  protected:
+
+    /**
+     * Un bloc reçu et sa date d'arrivée ; un bloc vide marque la fin du
+     * flot.
+     */
+    struct Arrival {
+      Chunk data;                 /** Le bloc. */
+      Clock::time_point stamp;    /** Sa date d'arrivée. */
+    };
+
+    /**
+     * Les éléments d'un flot reçus mais pas encore détachés : le suffixe
+     * d'un bloc commençant à la position pos.
+     */
+    struct Pending {
+      Chunk data;                   /** Le bloc courant. */
+      size_t pos = 0;               /** Le premier élément en attente. */
+      Clock::time_point arrival;    /** La date d'arrivée du bloc. */
+
+      bool empty() const {
+	return pos == data.size();
+      }
+
+      size_t size() const {
+	return data.size() - pos;
+      }
+
+      typename Chunk::const_iterator begin() const {
+	return data.cbegin() + pos;
+      }
+
+      /**
+       * Détache les count premiers éléments en attente.
+       *
+       * @param[in] count - le nombre d'éléments.
+       * @return les éléments détachés.
+       */
+      Chunk take(const size_t& count) {
+	Chunk part;
+	if (pos == 0 && count == data.size()) {
+	  part.swap(data);
+	  return part;
+	}
+	part.assign(std::make_move_iterator(data.begin() + pos),
+		    std::make_move_iterator(data.begin() + pos + count));
+	pos += count;
+	if (pos == data.size()) {
+	  data.clear();
+	  pos = 0;
+	}
+	return part;
+      }
+    };
+
+    /**
+     * Le préfixe sûr détaché des deux flots.
+     */
+    struct Batch {
+      Chunk parts[2];               /** Les éléments de A et de B. */
+      Clock::time_point arrival;    /** L'arrivée du plus ancien élément. */
+    };
+
+    /**
+     * Un bloc fusionné.
+     */
+    struct Merged {
+      Chunk data;                   /** Le bloc. */
+      Clock::time_point arrival;    /** L'arrivée du plus ancien élément. */
+    };
+
+    /**
+     * Attend le prochain bloc d'un flot.
+     *
+     * @param[in] side - le flot ;
+     * @param[out] pending - les éléments en attente du flot ;
+     * @param[out] open - faux si le flot est clos.
+     */
+    void refill(const size_t& side, Pending& pending, bool& open) {
+      Arrival arrival;
+      queues[side].pop(arrival);
+      if (arrival.data.empty()) {
+	open = false;
+	return;
+      }
+      pending.data = std::move(arrival.data);
+      pending.pos = 0;
+      pending.arrival = arrival.stamp;
+    }
+
+  private:
+
+    const Compare comp;                                   /** L'ordre. */
+    tbb::concurrent_bounded_queue< Arrival > queues[2];   /** Les files. */
+
+  }; // StreamingMerge
+
+} // merging
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef PEARSON_HPP
+#define PEARSON_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <tbb/tbb.h>
+
+/**
+ * @brief Data measurement set.
+ *
+ */
+struct Data_Set {
+  size_t n;  /** Number of measurements.  */
+  double *x; /** Variable X measurements. */
+  double *y; /** Variable Y measurements. */
+};
+
+/**
+ * @brief Pearson correlation.
+ *
+ */
+struct Correlation {
+  double a; /** Right slope.         */
+  double b; /** Y-axis shift.        */
+  double r; /** Pearson coefficient. */
+};
+
+/**
+ * @brief Calculates then returns the Pearson correlation of a data set.
+ *
+ * @param data_set The data set.
+ * @return Correlation The corresponding Pearson correlation.
+ */
+inline Correlation calculate(const Data_Set &data_set) noexcept;
+
+/* -------------------------------------------------------------------------- */
+/*                                  calculate                                 */
+/* -------------------------------------------------------------------------- */
+
+
+// utilisation parallel_ reduce de tbb
+
+// regroupe les variables necessaires pour calculer la corrélation
+struct PartialSums {
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_xx = 0.0;
+    double sum_yy = 0.0;
+    double sum_xy = 0.0;
+    size_t n = 0;
+
+    PartialSums() = default; // pour le constructeur par défaut
+
+    // combinaison des res partiels à partir des deux blocs
+    PartialSums(const PartialSums& a, const PartialSums& b) {
+        sum_x = a.sum_x + b.sum_x;
+        sum_y = a.sum_y + b.sum_y;
+        sum_xx = a.sum_xx + b.sum_xx;
+        sum_yy = a.sum_yy + b.sum_yy;
+        sum_xy = a.sum_xy + b.sum_xy;
+        n = a.n + b.n;
+    }
+
+    // fusion des résultats partiels
+    void operator+=(const PartialSums& other) {
+        sum_x += other.sum_x;
+        sum_y += other.sum_y;
+        sum_xx += other.sum_xx;
+        sum_yy += other.sum_yy;
+        sum_xy += other.sum_xy;
+        n += other.n;
+    }
+};
+
+// calcul de la corrélation 
+inline Correlation calculate(const Data_Set &data_set) noexcept {
+    // division du travail en blocs
+    PartialSums total = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, data_set.n),
+        PartialSums(),
+        [&](const tbb::blocked_range<size_t>& range, PartialSums partial) { // traite chaque bloc
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                const double x = data_set.x[i];
+                const double y = data_set.y[i];
+                partial.sum_x += x;
+                partial.sum_y += y;
+                partial.sum_xx += x * x;
+                partial.sum_yy += y * y;
+                partial.sum_xy += x * y;
+                partial.n++;
+            }
+            return partial;
+        },
+        [](const PartialSums& a, const PartialSums& b) {
+            return PartialSums(a, b);
+        }
+    );
+
+    // calcul des moyennes et des variances
+    const double mean_x = total.sum_x / total.n;
+    const double mean_y = total.sum_y / total.n;
+
+    const double covariance = total.sum_xy - total.n * mean_x * mean_y;
+    const double variance_x = total.sum_xx - total.n * mean_x * mean_x;
+    const double variance_y = total.sum_yy - total.n * mean_y * mean_y;
+
+    Correlation res;
+    res.a = covariance / variance_x;
+    res.b = mean_y - res.a * mean_x;
+    res.r = covariance / std::sqrt(variance_x * variance_y);
+
+    return res;
+}
+
+#endif
@@ -17,4 +17,10 @@
     return EXIT_FAILURE;                                                       \
   }
 
+#define CPP_ARGV_TEST_ARG_RANGE(argc, min, max)                                \
+  if (argc < min || argc > max) {                                              \
+    std::cerr << "Bad argument number" << std::endl;                           \
+    return EXIT_FAILURE;                                                       \
+  }
+
 #endif
@@ -2,6 +2,8 @@
 #include "Metrics.hpp"
 #include <vector>
 #include <numeric>
+#include <utility>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <chrono>
@@ -71,8 +73,8 @@ int main(int argc, char* argv[]) {
     	       comp);
   }
   stop = std::chrono::steady_clock::now();
-  const int seq = 
-    std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count();  
+  const double seq = 
+    std::chrono::duration< double, std::milli >(stop - start).count();  
 
   // Affichage des performances de la version séquentielle.
   std::cout << "--[ merge: begin ]--" << std::endl;
@@ -90,50 +92,121 @@ int main(int argc, char* argv[]) {
   omp_set_num_threads(threads);  
   
 
-  // L'algorithme ParallelStableMerge ne peut fonctionner qu'avec une relation
-  // d'ordre telle que <= ou >= mais pas < ou >, ce qui est justement notre
-  // cas. Nous allons donc ruser en deux temps :
-  // 1) nous allons définir la relation d'ordre inverse : ici >=.
-  // 2) nous allons fusionner nos conteneurs en les balayant tous de la droite
-  //    vers la gauche.
-  // 3) Bonjour le mal de tête ...
+  // Jusqu'ici, ParallelStableMerge ne fonctionnait qu'avec une relation
+  // d'ordre telle que <= ou >= : nous fusionnions nos conteneurs de la droite
+  // vers la gauche (itérateurs inverses) avec la relation inverse >=. Elle
+  // accepte désormais directement une relation stricte telle que <, ce qui
+  // permet de balayer les conteneurs dans le sens direct (memmove,
+  // vectorisation, préchargement matériel). Les deux versions sont
+  // comparées.
   const auto invComp = std::greater_equal< const Type& >();
 
   // Durée d'exécution de l'algorithme ParallelStableMerge. 
   
-  // pour le nombre de threads max
-  start = std::chrono::steady_clock::now();
-  for (size_t i = 0; i != iters; i ++) {
-    merging::ParallelStableMerge::apply(lhs.rbegin(), 
-					  lhs.rend(),
-					  rhs.rbegin(), 
-					  rhs.rend(),
-					  result.rbegin(),
-					  invComp,
-					  threads);
-  }
-  stop = std::chrono::steady_clock::now();
-  const int par = std::chrono::duration_cast< std::chrono::milliseconds >(stop - start).count();    
-
-  // Affichage des résultats de la version parallèle avec, en plus, le calcul
-  // des facteurs d'accélération et d'efficacité. Une accélération sur-linéaire
-  // indique une meilleure utilisation des caches L2 (partagé) et L1 (privé).  
+  // Balayage du nombre de threads, de 1 au nombre de threads max.
+  std::vector< unsigned > procs;
+  std::vector< double > pars;
+  for (int nb = 1; nb <= threads; nb ++) {
+
+    // Sens inverse avec la relation >=.
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelStableMerge::apply(lhs.rbegin(), 
+					    lhs.rend(),
+					    rhs.rbegin(), 
+					    rhs.rend(),
+					    result.rbegin(),
+					    invComp,
+					    nb);
+    }
+    stop = std::chrono::steady_clock::now();
+    const double rev = std::chrono::duration< double, std::milli >(stop - start).count();
+    const bool revOk = std::is_sorted(result.begin(), result.end(), comp);
+
+    // Sens direct avec la relation <.
+    std::fill(result.begin(), result.end(), 0);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelStableMerge::apply(lhs.begin(), 
+					    lhs.end(),
+					    rhs.begin(), 
+					    rhs.end(),
+					    result.begin(),
+					    comp,
+					    nb);
+    }
+    stop = std::chrono::steady_clock::now();
+    const double par = std::chrono::duration< double, std::milli >(stop - start).count();    
+    procs.push_back(nb);
+    pars.push_back(par);
+
+    // Affichage des résultats de la version parallèle avec, en plus, le calcul
+    // des facteurs d'accélération et d'efficacité. Une accélération sur-linéaire
+    // indique une meilleure utilisation des caches L2 (partagé) et L1 (privé).  
     std::cout << "--[ ParallelStableMerge: begin ]--" << std::endl;
-    std::cout << "\tThread(s):\t" << threads << std::endl;
+    std::cout << "\tThread(s):\t" << nb << std::endl;
+    std::cout << "\tDurée (inverse):\t" << rev << " msec." << std::endl;
+    std::cout << "\tVerdict (inverse):\t"
+  	      << std::boolalpha 
+  	      << revOk
+  	      << std::endl;
     std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
     std::cout << "\tVerdict:\t\t"
   	      << std::boolalpha 
   	      << std::is_sorted(result.begin(), result.end(), comp)
   	      << std::endl;
+    std::cout << "\tDirect/inverse:\t"
+  	      << Metrics::speedup(rev, par)
+  	      << std::endl;
     std::cout << "\tSpeedup:\t" 
   	      << Metrics::speedup(seq, par)
   	      << std::endl;
     std::cout << "\tEfficiency:\t"
-  	      << Metrics::efficiency(seq, par, threads)
+  	      << Metrics::efficiency(seq, par, nb)
   	      << std::endl;
     std::cout << "--[ parallelStableMerge: end ]--" << std::endl;
     std::cout << std::endl;
-  
+  }
+
+  // Stabilité : des enregistrements (clé, origine) comparés sur leur seule
+  // clé doivent être fusionnés comme par std::merge, à clés égales ceux du
+  // premier conteneur d'abord, que la relation soit stricte ou non.
+  {
+    typedef std::pair< int, int > Record;
+    std::vector< Record > first(1000), second(1000);
+    for (size_t i = 0; i != first.size(); i ++) {
+      first[i] = Record(static_cast< int >(i / 7), 1);
+      second[i] = Record(static_cast< int >(i / 5), 2);
+    }
+    std::vector< Record > expected(first.size() + second.size());
+    std::vector< Record > strict(expected.size()), large(expected.size());
+    const auto less = [](const Record& a, const Record& b) {
+      return a.first < b.first;
+    };
+    const auto lessEqual = [](const Record& a, const Record& b) {
+      return a.first <= b.first;
+    };
+    std::merge(first.begin(), first.end(), second.begin(), second.end(),
+	       expected.begin(), less);
+    merging::ParallelStableMerge::apply(first.begin(), first.end(),
+					second.begin(), second.end(),
+					strict.begin(),
+					merging::ParallelStableMerge::strict(less),
+					threads);
+    merging::ParallelStableMerge::apply(first.begin(), first.end(),
+					second.begin(), second.end(),
+					large.begin(), lessEqual, threads);
+    std::cout << "--[ Stabilité: begin ]--" << std::endl;
+    std::cout << "\tVerdict (<):\t\t" << std::boolalpha
+	      << (strict == expected) << std::endl;
+    std::cout << "\tVerdict (<=):\t\t" << std::boolalpha
+	      << (large == expected) << std::endl;
+    std::cout << "--[ Stabilité: end ]--" << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Lois d'échelle ajustées sur le balayage et nombre de threads optimal.
+  Metrics::report(std::cout, Metrics::scaling(seq, procs, pars));
 
   // Tout s'est bien passé.
   return EXIT_SUCCESS;
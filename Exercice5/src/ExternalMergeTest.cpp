@@ -0,0 +1,163 @@
+#include "ExternalMerge.hpp"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <omp.h>
+#include <unistd.h>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef std::int64_t Type;
+
+/**
+ * Écrit un fichier trié : le sous-conteneur s (sur k) contient les valeurs
+ * i * k + s, de sorte que la fusion des k fichiers soit la suite 0, 1, 2...
+ *
+ * @param[in] path - le chemin du fichier ;
+ * @param[in] s - le rang du fichier ;
+ * @param[in] k - le nombre de fichiers ;
+ * @param[in] size - le nombre d'éléments du fichier.
+ * @return vrai si l'écriture a réussi.
+ */
+bool
+generate(const std::string& path, const size_t& s, const size_t& k,
+	 const size_t& size) {
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  std::vector< Type > block(1 << 16);
+  for (size_t i = 0; i < size; i += block.size()) {
+    const size_t count = std::min(block.size(), size - i);
+    for (size_t e = 0; e != count; e ++) {
+      block[e] = static_cast< Type >((i + e) * k + s);
+    }
+    stream.write(reinterpret_cast< const char* >(block.data()),
+		 count * sizeof(Type));
+  }
+  return static_cast< bool >(stream);
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0]
+	      << " nb_fichiers nb_elements_par_fichier [nb_elements_fenetre]"
+	      << std::endl;
+    std::cout << "\tLes fichiers sont créés dans $TMPDIR (/tmp à défaut)."
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 ou 3 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc != 3 && argc != 4) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre de fichiers, du nombre d'éléments de
+  // chacun et de la taille d'une fenêtre (8 Mi éléments, 64 Mo, par
+  // défaut).
+  size_t k, size, window = 8 * 1024 * 1024;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> k;
+    if (! entree || ! entree.eof() || k == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (argc == 4) {
+    std::istringstream entree(argv[3]);
+    entree >> window;
+    if (! entree || ! entree.eof() || window == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Création des fichiers sources triés.
+  const char* const tmp = std::getenv("TMPDIR");
+  const std::string prefix = std::string(tmp != nullptr ? tmp : "/tmp") +
+    "/external_merge_" + std::to_string(getpid()) + "_";
+  std::vector< std::string > inputs;
+  for (size_t s = 0; s != k; s ++) {
+    inputs.push_back(prefix + std::to_string(s) + ".bin");
+    if (! generate(inputs.back(), s, k, size)) {
+      std::cerr << "Impossible d'écrire " << inputs.back() << std::endl;
+      for (const std::string& path : inputs) {
+	std::remove(path.c_str());
+      }
+      return EXIT_FAILURE;
+    }
+  }
+  const std::string output = prefix + "fusion.bin";
+
+  // Fusion hors mémoire puis vérification en flux du fichier cible.
+  const int threads = omp_get_max_threads();
+  bool ok = false;
+  size_t total = 0;
+  double duration = 0;
+  try {
+    const auto start = std::chrono::steady_clock::now();
+    total = merging::ExternalMerge::apply< Type >(inputs, output, threads,
+						  window);
+    const auto stop = std::chrono::steady_clock::now();
+    duration =
+      std::chrono::duration< double, std::milli >(stop - start).count();
+
+    const merging::MappedRun< Type > result(output);
+    ok = result.size() == k * size;
+    for (size_t i = 0; ok && i < result.size(); i += window) {
+      const size_t end = std::min(i + window, result.size());
+      for (size_t e = i; ok && e != end; e ++) {
+	ok = result.begin()[e] == static_cast< Type >(e);
+      }
+      result.release(i, end);
+    }
+  }
+  catch (const std::system_error& e) {
+    std::cerr << "Erreur d'entrée-sortie : " << e.what() << std::endl;
+  }
+  for (const std::string& path : inputs) {
+    std::remove(path.c_str());
+  }
+  std::remove(output.c_str());
+
+  const double megas = 2.0 * total * sizeof(Type) / (1024 * 1024);
+  std::cout << "--[ Fusion hors mémoire: begin ]--" << std::endl;
+  std::cout << "\tFichiers:\t" << k << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tFenêtre:\t" << window << " éléments" << std::endl;
+  std::cout << "\tDurée:\t\t" << duration << " msec." << std::endl;
+  std::cout << "\tDébit:\t\t" << megas * 1000 / duration
+	    << " Mo/s (lecture et écriture)" << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << ok << std::endl;
+  std::cout << "--[ Fusion hors mémoire: end ]--" << std::endl;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
@@ -0,0 +1,159 @@
+#include "Exercice5Test.hpp"
+#include "HugePageArena.hpp"
+#include "PerfCounters.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Chronomètre des fusions répétées et relève les défauts de TLB de données
+ * lorsque les compteurs matériels sont disponibles.
+ *
+ * @param[in] name - le nom de la variante ;
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] run - une répétition (allocation du résultat puis fusion),
+ *   retournant son verdict.
+ * @return la durée totale en millisecondes.
+ */
+double
+measure(const std::string& name, const size_t& iters,
+	const std::function< bool() >& run) {
+  PerfCounters counters;
+  bool ok = true;
+  counters.start();
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    ok = run() && ok;
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  const PerfCounters::Sample total = PerfCounters::total(counters.stop());
+  const double duration =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << duration << " msec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << ok << std::endl;
+  std::cout << "\tDéfauts dTLB:\t";
+  if (total.valid[PerfCounters::DTLB_MISSES]) {
+    std::cout << total.values[PerfCounters::DTLB_MISSES];
+  }
+  else {
+    std::cout << "indisponibles";
+  }
+  std::cout << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+  return duration;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque conteneur à fusionner.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Relation d'ordre utilisée : inférieur ou égal à.
+  const auto comp = std::less_equal< const Type& >();
+  const int threads = omp_get_max_threads();
+
+  // Les deux conteneurs triés, placés dans l'arène.
+  merging::HugePageArena inputs;
+  typedef merging::ArenaAllocator< Type > Allocator;
+  std::vector< Type, Allocator > lhs(size, Allocator(inputs));
+  std::vector< Type, Allocator > rhs(size, Allocator(inputs));
+  for (size_t i = 0; i != size; i ++) {
+    lhs[i] = 2 * i;
+    rhs[i] = 2 * i + 1;
+  }
+
+  // Conteneur cible alloué à chaque fusion en pages normales : chaque
+  // répétition paie l'allocation et les défauts de page de 4 Ko.
+  const double normal =
+    measure("std::vector", iters, [&]() {
+	std::vector< Type > result(2 * size);
+	merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+					    rhs.begin(), rhs.end(),
+					    result.begin(),
+					    comp,
+					    threads);
+	return std::is_sorted(result.begin(), result.end());
+      });
+
+  // Conteneur cible puisé dans une arène remise à zéro après chaque fusion :
+  // les grandes pages sont projetées une seule fois puis réutilisées.
+  merging::HugePageArena outputs;
+  const double huge =
+    measure("HugePageArena", iters, [&]() {
+	std::vector< Type, Allocator > result(2 * size, Allocator(outputs));
+	merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+					    rhs.begin(), rhs.end(),
+					    result.begin(),
+					    comp,
+					    threads);
+	const bool ok = std::is_sorted(result.begin(), result.end());
+	outputs.reset();
+	return ok;
+      });
+
+  std::cout << "--[ Arène: begin ]--" << std::endl;
+  std::cout << "\tPages:\t\t"
+	    << merging::HugePageArena::name(outputs.backing()) << std::endl;
+  std::cout << "\tProjeté:\t" << outputs.reserved() / (1024 * 1024)
+	    << " Mo" << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(normal, huge) << std::endl;
+  std::cout << "--[ Arène: end ]--" << std::endl;
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
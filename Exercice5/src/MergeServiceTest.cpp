@@ -0,0 +1,184 @@
+#include "MergeService.hpp"
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Synonyme du type des éléments des listes.
+ */
+typedef int Type;
+
+/**
+ * Synonyme du type des conteneurs.
+ */
+typedef std::vector< Type > Vector;
+
+/**
+ * Mesure, appel par appel, la durée d'exécution d'une fonction.
+ *
+ * @param[in] iters - le nombre d'appels ;
+ * @param[in] f - la fonction à chronométrer.
+ * @return les durées des appels en microsecondes.
+ */
+std::vector< double >
+measure(const size_t& iters, const std::function< void() >& f) {
+  std::vector< double > latencies(iters);
+  for (size_t i = 0; i != iters; i ++) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto stop = std::chrono::steady_clock::now();
+    latencies[i] =
+      std::chrono::duration< double, std::micro >(stop - start).count();
+  }
+  return latencies;
+}
+
+/**
+ * Affiche les quantiles des durées d'exécution.
+ *
+ * @param[in] name - le nom de la version mesurée ;
+ * @param[in,out] latencies - les durées d'exécution (triées en sortie) ;
+ * @param[in] ok - le verdict.
+ */
+void
+report(const std::string& name, std::vector< double >& latencies,
+       const bool& ok) {
+  std::sort(latencies.begin(), latencies.end());
+  const auto quantile = [&](const double& q) {
+    return latencies[static_cast< size_t >(q * (latencies.size() - 1))];
+  };
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tp50:\t\t" << quantile(0.50) << " usec." << std::endl;
+  std::cout << "\tp95:\t\t" << quantile(0.95) << " usec." << std::endl;
+  std::cout << "\tp99:\t\t" << quantile(0.99) << " usec." << std::endl;
+  std::cout << "\tmax:\t\t" << latencies.back() << " usec." << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << ok << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque liste.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Relation d'ordre utilisée : inférieur ou égal à.
+  const auto comp = std::less_equal< const Type& >();
+  const int threads = omp_get_max_threads();
+  std::cout << "Thread(s):\t" << threads << std::endl;
+  std::cout << "Éléments:\t" << 2 * size << std::endl;
+  std::cout << std::endl;
+
+  // Deux listes triées et leur fusion de référence.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution;
+  Vector lhs(size), rhs(size), expected(2 * size), result(2 * size);
+  for (Type& x : lhs) {
+    x = distribution(generator);
+  }
+  for (Type& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	     expected.begin());
+
+  // Le service démarre son équipe une fois pour toutes.
+  merging::MergeService service(threads);
+
+  // Coût d'un appel seul : fusion de deux listes vides.
+  {
+    const Vector empty;
+    auto latencies = measure(iters, [&]() {
+	merging::ParallelStableMerge::apply(empty.begin(), empty.end(),
+					    empty.begin(), empty.end(),
+					    result.begin(), comp, threads);
+      });
+    report("appel vide, fork/join", latencies, true);
+    latencies = measure(iters, [&]() {
+	service.apply(empty.begin(), empty.end(),
+		      empty.begin(), empty.end(),
+		      result.begin(), comp);
+      });
+    report("appel vide, MergeService", latencies, true);
+  }
+
+  // Fusions : référence séquentielle, fork/join OpenMP, service.
+  bool ok = true;
+  auto latencies = measure(iters, [&]() {
+      merging::MergeKernel::apply(lhs.begin(), lhs.end(),
+				  rhs.begin(), rhs.end(),
+				  result.begin(), comp);
+    });
+  report("MergeKernel (séquentiel)", latencies, result == expected);
+
+  std::fill(result.begin(), result.end(), 0);
+  latencies = measure(iters, [&]() {
+      merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+					  rhs.begin(), rhs.end(),
+					  result.begin(), comp, threads);
+    });
+  ok = result == expected;
+  report("ParallelStableMerge::apply (fork/join)", latencies, ok);
+
+  std::fill(result.begin(), result.end(), 0);
+  latencies = measure(iters, [&]() {
+      service.apply(lhs.begin(), lhs.end(),
+		    rhs.begin(), rhs.end(),
+		    result.begin(), comp);
+    });
+  ok = result == expected;
+  report("MergeService::apply", latencies, ok);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
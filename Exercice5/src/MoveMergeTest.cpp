@@ -0,0 +1,183 @@
+#include "Exercice5Test.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <atomic>
+#include <new>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Nombre d'allocations dynamiques effectuées par le programme.
+ */
+static std::atomic< size_t > allocations(0);
+
+/**
+ * Opérateurs d'allocation globaux comptant les allocations.
+ */
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void* const p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+/**
+ * Remplit un conteneur de chaînes triées, trop longues pour l'optimisation
+ * des petites chaînes : chaque copie provoque donc une allocation.
+ *
+ * @param[out] data - le conteneur à remplir ;
+ * @param[in,out] generator - le générateur pseudo-aléatoire.
+ */
+void
+fill(std::vector< std::string >& data, std::mt19937& generator) {
+  std::uniform_int_distribution< int > distribution(0, 99999999);
+  for (auto& x : data) {
+    std::ostringstream stream;
+    stream << "element-de-fusion-numero-";
+    stream.width(8);
+    stream.fill('0');
+    stream << distribution(generator);
+    x = stream.str();
+  }
+  std::sort(data.begin(), data.end());
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Taille de chaque conteneur à fusionner.
+  const size_t size = 512 * 1024;
+
+  // init du scheduler d'openmp
+  const int threads = omp_get_max_threads();
+
+  // Deux conteneurs triés de chaînes aléatoires et leur fusion attendue.
+  std::mt19937 generator(19);
+  std::vector< std::string > lhs(size), rhs(size + 211);
+  fill(lhs, generator);
+  fill(rhs, generator);
+  std::vector< std::string > expected(lhs.size() + rhs.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	     expected.begin(),
+	     std::less_equal< const std::string& >());
+
+  // Durée d'exécution et nombre d'allocations de la fusion par recopie. Le
+  // conteneur cible est vidé avant chaque fusion sans être chronométré.
+  std::vector< std::string > result;
+  double copy = 0;
+  size_t copyAllocs = 0;
+  bool copyOk = true;
+  for (size_t i = 0; i != iters; i ++) {
+    result.assign(expected.size(), std::string());
+    const size_t before = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+					   rhs.begin(), rhs.end(),
+					   result.begin(),
+					   threads);
+    const auto stop = std::chrono::steady_clock::now();
+    copyAllocs += allocations.load() - before;
+    copy += std::chrono::duration< double, std::milli >(stop - start).count();
+    copyOk = copyOk && result == expected;
+  }
+
+  std::cout << "--[ ParallelStableMerge<string>: begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée:\t\t" << copy << " msec." << std::endl;
+  std::cout << "\tAllocations:\t" << copyAllocs << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << copyOk
+	    << std::endl;
+  std::cout << "--[ ParallelStableMerge: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // Durée d'exécution et nombre d'allocations de la fusion par déplacement.
+  // Les conteneurs sources, consommés, sont reconstitués avant chaque fusion
+  // sans être chronométrés.
+  std::vector< std::string > lhsWork, rhsWork;
+  double move = 0;
+  size_t moveAllocs = 0;
+  bool moveOk = true;
+  for (size_t i = 0; i != iters; i ++) {
+    lhsWork = lhs;
+    rhsWork = rhs;
+    result.assign(expected.size(), std::string());
+    const size_t before = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    merging::ParallelStableMerge::applyMove(lhsWork.begin(), lhsWork.end(),
+					       rhsWork.begin(), rhsWork.end(),
+					       result.begin(),
+					       threads);
+    const auto stop = std::chrono::steady_clock::now();
+    moveAllocs += allocations.load() - before;
+    move += std::chrono::duration< double, std::milli >(stop - start).count();
+    moveOk = moveOk && result == expected;
+  }
+
+  std::cout << "--[ ParallelStableMerge::applyMove<string>: begin ]--"
+	    << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tDurée:\t\t" << move << " msec." << std::endl;
+  std::cout << "\tAllocations:\t" << moveAllocs << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << moveOk
+	    << std::endl;
+  std::cout << "\tSpeedup:\t"
+	    << Metrics::speedup(copy, move)
+	    << std::endl;
+  std::cout << "--[ ParallelStableMerge::applyMove: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,184 @@
+#include "ParallelMultiwayMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Fusion séquentielle de k sous-conteneurs triés consécutifs par un arbre de
+ * fusions deux à deux : la mémoire est lue et écrite log2(k) fois.
+ *
+ * @param[in,out] data - le conteneur regroupant les k sous-conteneurs ;
+ * @param[in] bounds - les k + 1 bornes des sous-conteneurs dans data ;
+ * @param[in,out] buffer - un tampon de même taille que data ;
+ * @param[in] comp - la relation d'ordre.
+ * @return le conteneur (data ou buffer) accueillant le résultat.
+ */
+template< typename Type,
+	  typename Compare >
+const std::vector< Type >&
+pairwiseMerge(std::vector< Type >& data,
+	      std::vector< size_t > bounds,
+	      std::vector< Type >& buffer,
+	      const Compare& comp) {
+  std::vector< Type >* from = &data;
+  std::vector< Type >* to = &buffer;
+  while (bounds.size() > 2) {
+    std::vector< size_t > next;
+    for (size_t s = 0; s + 1 < bounds.size(); s += 2) {
+      next.push_back(bounds[s]);
+      if (s + 2 < bounds.size()) {
+	std::merge(from->begin() + bounds[s], from->begin() + bounds[s + 1],
+		   from->begin() + bounds[s + 1], from->begin() + bounds[s + 2],
+		   to->begin() + bounds[s],
+		   comp);
+      }
+      else {
+	std::copy(from->begin() + bounds[s], from->begin() + bounds[s + 1],
+		  to->begin() + bounds[s]);
+      }
+    }
+    next.push_back(bounds.back());
+    bounds.swap(next);
+    std::swap(from, to);
+  }
+  return *from;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 1 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 2) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations.
+  size_t iters;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à fusionner.
+  typedef int Type;
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+
+  // Taille totale des sous-conteneurs à fusionner.
+  const size_t size = 4 * 1024 * 1024;
+
+  // init du scheduler d'openmp
+  const int threads = omp_get_max_threads();
+
+  // Générateur pseudo-aléatoire à graine fixe pour la reproductibilité.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution;
+
+  for (size_t k : { 16, 64, 256 }) {
+
+    // k sous-conteneurs triés de tailles inégales, stockés consécutivement.
+    std::vector< Type > data(size), buffer(size), work(size), result(size);
+    for (auto& x : data) {
+      x = distribution(generator);
+    }
+    std::vector< size_t > bounds(1, 0);
+    for (size_t s = 1; s < k; s ++) {
+      bounds.push_back(generator() % size);
+    }
+    bounds.push_back(size);
+    std::sort(bounds.begin(), bounds.end());
+    std::vector< std::pair< std::vector< Type >::const_iterator,
+			    std::vector< Type >::const_iterator > > sequences;
+    for (size_t s = 0; s != k; s ++) {
+      std::sort(data.begin() + bounds[s], data.begin() + bounds[s + 1], comp);
+      sequences.emplace_back(data.cbegin() + bounds[s],
+			     data.cbegin() + bounds[s + 1]);
+    }
+
+    // Durée d'exécution de l'arbre de fusions deux à deux (std::merge). La
+    // recopie de la donnée avant chaque fusion n'est pas chronométrée.
+    double seq = 0;
+    bool seqOk = true;
+    std::vector< Type > expected;
+    for (size_t i = 0; i != iters; i ++) {
+      std::copy(data.begin(), data.end(), work.begin());
+      const auto start = std::chrono::steady_clock::now();
+      const std::vector< Type >& merged = pairwiseMerge(work, bounds, buffer,
+							comp);
+      const auto stop = std::chrono::steady_clock::now();
+      seq += std::chrono::duration< double, std::milli >(stop - start).count();
+      seqOk = std::is_sorted(merged.begin(), merged.end(), comp);
+      expected = merged;
+    }
+
+    // Affichage des performances de la version séquentielle.
+    std::cout << "--[ merge (k = " << k << "): begin ]--" << std::endl;
+    std::cout << "\tDurée:\t\t" << seq << " msec." << std::endl;
+    std::cout << "\tVerdict:\t\t"
+	      << std::boolalpha
+	      << seqOk
+	      << std::endl;
+    std::cout << "--[ merge: end ]--" << std::endl;
+    std::cout << std::endl;
+
+    // Durée d'exécution de l'algorithme ParallelMultiwayMerge.
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelMultiwayMerge::apply(sequences,
+					    result.begin(),
+					    comp,
+					    threads);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double par =
+      std::chrono::duration< double, std::milli >(stop - start).count();
+
+    // Affichage des résultats de la version parallèle avec, en plus, le calcul
+    // des facteurs d'accélération et d'efficacité.
+    std::cout << "--[ ParallelMultiwayMerge (k = " << k << "): begin ]--"
+	      << std::endl;
+    std::cout << "\tThread(s):\t" << threads << std::endl;
+    std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
+    std::cout << "\tVerdict:\t\t"
+	      << std::boolalpha
+	      << (iters == 0 || result == expected)
+	      << std::endl;
+    std::cout << "\tSpeedup:\t"
+	      << Metrics::speedup(seq, par)
+	      << std::endl;
+    std::cout << "\tEfficiency:\t"
+	      << Metrics::efficiency(seq, par, threads)
+	      << std::endl;
+    std::cout << "--[ ParallelMultiwayMerge: end ]--" << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,233 @@
+#include "Exercice5Test.hpp"
+#include "Numa.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Retourne le nœud NUMA possédant la page d'une adresse (appel système
+ * move_pages sans déplacement).
+ *
+ * @param[in] address - l'adresse.
+ * @return le nœud ou une valeur négative s'il est inconnu.
+ */
+int
+pageNode(const void* address) {
+#if defined(SYS_move_pages)
+  void* page = const_cast< void* >(address);
+  int status = -1;
+  if (syscall(SYS_move_pages, 0, 1, &page, nullptr, &status, 0) != 0) {
+    return -1;
+  }
+  return status;
+#else
+  (void) address;
+  return -1;
+#endif
+}
+
+/**
+ * Affiche, pour chaque fragment du conteneur cible, le nœud prévu et celui
+ * qui possède effectivement sa première page.
+ *
+ * @param[in] result - le conteneur cible ;
+ * @param[in] threads - le nombre de fragments.
+ */
+template< typename Vector >
+void
+placement(const Vector& result, const int& threads) {
+  const size_t taille = (result.size() + threads - 1) / threads;
+  std::cout << "\tFragment\tNœud prévu\tNœud effectif" << std::endl;
+  for (int r = 0; r != threads && r * taille < result.size(); r ++) {
+    const int actual = pageNode(&result[r * taille]);
+    std::cout << '\t' << r
+	      << "\t\t" << merging::Numa::node(r, threads)
+	      << "\t\t";
+    if (actual >= 0) {
+      std::cout << actual;
+    }
+    else {
+      std::cout << '?';
+    }
+    std::cout << std::endl;
+  }
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    std::cout << "\tPARA_NUMA_NODES=k simule k nœuds sur une machine à un"
+	      << " seul nœud." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque conteneur à fusionner.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Relation d'ordre utilisée : inférieur ou égal à.
+  const auto comp = std::less_equal< const Type& >();
+
+  // Nombre de threads et de nœuds.
+  const int threads = omp_get_max_threads();
+  std::cout << "--[ Topologie: begin ]--" << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "\tNœud(s):\t" << merging::Numa::nodes() << std::endl;
+  std::cout << "--[ Topologie: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // Premier accès séquentiel : le thread principal initialise les trois
+  // conteneurs, dont toutes les pages se trouvent alors sur son nœud.
+  double seq;
+  bool seqOk;
+  {
+    std::vector< Type > lhs(size), rhs(size), result(2 * size);
+    for (size_t i = 0; i != size; i ++) {
+      lhs[i] = 2 * i;
+      rhs[i] = 2 * i + 1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+					  rhs.begin(), rhs.end(),
+					  result.begin(),
+					  comp,
+					  threads);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    seq = std::chrono::duration< double, std::milli >(stop - start).count();
+    seqOk = std::is_sorted(result.begin(), result.end());
+
+    std::cout << "--[ Premier accès séquentiel: begin ]--" << std::endl;
+    std::cout << "\tDurée:\t\t" << seq << " msec." << std::endl;
+    std::cout << "\tVerdict:\t\t" << std::boolalpha << seqOk << std::endl;
+    placement(result, threads);
+    std::cout << "--[ Premier accès séquentiel: end ]--" << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Premier accès parallèle : chaque fragment est touché en premier par le
+  // thread qui le fusionnera, épinglé sur son nœud.
+  {
+    typedef merging::FirstTouchAllocator< Type > Allocator;
+    std::vector< Type, Allocator > lhs(size), rhs(size), result(2 * size);
+    merging::Numa::firstTouch(lhs.begin(), lhs.end(), threads);
+    merging::Numa::firstTouch(rhs.begin(), rhs.end(), threads);
+    merging::Numa::firstTouch(result.begin(), result.end(), threads);
+    for (size_t i = 0; i != size; i ++) {
+      lhs[i] = 2 * i;
+      rhs[i] = 2 * i + 1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i != iters; i ++) {
+      merging::ParallelStableMerge::applyPinned(lhs.begin(), lhs.end(),
+						rhs.begin(), rhs.end(),
+						result.begin(),
+						comp,
+						threads);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double par =
+      std::chrono::duration< double, std::milli >(stop - start).count();
+
+    std::cout << "--[ Premier accès parallèle: begin ]--" << std::endl;
+    std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
+    std::cout << "\tVerdict:\t\t"
+	      << std::boolalpha
+	      << (seqOk && std::is_sorted(result.begin(), result.end()))
+	      << std::endl;
+    std::cout << "\tSpeedup:\t"
+	      << Metrics::speedup(seq, par)
+	      << std::endl;
+    placement(result, threads);
+    std::cout << "--[ Premier accès parallèle: end ]--" << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Équipe réduite : aucune région parallèle n'étant active (comme depuis
+  // une région englobante sans parallélisme imbriqué), chaque région de
+  // firstTouch et applyPinned ne compte qu'un thread pour plusieurs
+  // fragments ; tous doivent être traités.
+  {
+    const int slices = 2 * std::max(threads, 2);
+    std::vector< Type > lhs(size), rhs(size), result(2 * size);
+    for (size_t i = 0; i != size; i ++) {
+      lhs[i] = 2 * i;
+      rhs[i] = 2 * i + 1;
+    }
+    std::vector< Type > expected(2 * size);
+    std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	       expected.begin());
+    std::vector< Type > touched(2 * size, 1);
+    const int levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(0);
+    merging::Numa::firstTouch(touched.begin(), touched.end(), slices);
+    merging::ParallelStableMerge::applyPinned(lhs.begin(), lhs.end(),
+					      rhs.begin(), rhs.end(),
+					      result.begin(),
+					      comp,
+					      slices);
+    omp_set_max_active_levels(levels);
+    const bool ok = result == expected &&
+      std::count(touched.begin(), touched.end(), Type()) ==
+      static_cast< std::ptrdiff_t >(touched.size());
+
+    std::cout << "--[ Équipe réduite: begin ]--" << std::endl;
+    std::cout << "	Fragments:	" << slices << std::endl;
+    std::cout << "	Verdict:		" << std::boolalpha << ok << std::endl;
+    std::cout << "--[ Équipe réduite: end ]--" << std::endl;
+    std::cout << std::endl;
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
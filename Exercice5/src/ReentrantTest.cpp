@@ -0,0 +1,226 @@
+#include "Exercice5Test.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Synonyme du type des éléments des listes.
+ */
+typedef int Type;
+
+/**
+ * Synonyme du type des conteneurs.
+ */
+typedef std::vector< Type > Vector;
+
+/**
+ * Synonyme du type d'une fusion : sources, cible.
+ */
+typedef std::function< void(const Vector&, const Vector&, Vector&) > Merge;
+
+/**
+ * Chronomètre l'exécution d'une fonction.
+ *
+ * @param[in] f - la fonction à chronométrer.
+ * @return la durée en millisecondes.
+ */
+double
+timed(const std::function< void() >& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration< double, std::milli >(stop - start).count();
+}
+
+/**
+ * Affiche les durées de la fusion qui ouvre sa propre région parallèle et de
+ * la fusion réentrante dans un même contexte d'appel.
+ *
+ * @param[in] name - le nom du contexte d'appel ;
+ * @param[in] forked - la durée avec apply ;
+ * @param[in] forkedOk - son verdict ;
+ * @param[in] reentrant - la durée avec applyReentrant ;
+ * @param[in] reentrantOk - son verdict.
+ */
+void
+report(const std::string& name,
+       const double& forked, const bool& forkedOk,
+       const double& reentrant, const bool& reentrantOk) {
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tapply:\t\t\t" << forked << " msec.\t" << std::boolalpha
+	    << forkedOk << std::endl;
+  std::cout << "\tapplyReentrant:\t\t" << reentrant << " msec.\t"
+	    << std::boolalpha << reentrantOk << std::endl;
+  std::cout << "\tSpeedup:\t\t" << Metrics::speedup(forked, reentrant)
+	    << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque liste.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const int threads = omp_get_max_threads();
+
+  // Deux listes triées et leur fusion de référence.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution(0, size);
+  Vector lhs(size), rhs(size), reference(2 * size);
+  for (Type& x : lhs) {
+    x = distribution(generator);
+  }
+  for (Type& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	     reference.begin());
+
+  const Merge forked = [&](const Vector& a, const Vector& b, Vector& c) {
+    merging::ParallelStableMerge::apply(a.begin(), a.end(),
+					b.begin(), b.end(),
+					c.begin(), threads);
+  };
+  const Merge reentrant = [&](const Vector& a, const Vector& b, Vector& c) {
+    merging::ParallelStableMerge::applyReentrant(a.begin(), a.end(),
+						 b.begin(), b.end(),
+						 c.begin(), threads);
+  };
+
+  // Démarrage de l'équipe persistante hors des mesures.
+  {
+    Vector result(2 * size);
+    reentrant(lhs, rhs, result);
+  }
+
+  // Contexte 1 : hors de toute région parallèle. apply ouvre une région par
+  // appel, applyReentrant réutilise l'équipe persistante.
+  {
+    Vector result1(2 * size), result2(2 * size);
+    const double t1 = timed([&]() {
+	for (size_t i = 0; i != iters; i ++) {
+	  forked(lhs, rhs, result1);
+	}
+      });
+    const double t2 = timed([&]() {
+	for (size_t i = 0; i != iters; i ++) {
+	  reentrant(lhs, rhs, result2);
+	}
+      });
+    report("hors région", t1, result1 == reference, t2, result2 == reference);
+  }
+
+  // Contexte 2 : depuis le bloc single d'une région parallèle englobante.
+  // apply ouvre une région imbriquée (sérialisée si le parallélisme imbriqué
+  // est désactivé), applyReentrant confie ses fragments à l'équipe.
+  {
+    Vector result1(2 * size), result2(2 * size);
+    const double t1 = timed([&]() {
+	#pragma omp parallel num_threads(threads)
+	#pragma omp single
+	for (size_t i = 0; i != iters; i ++) {
+	  forked(lhs, rhs, result1);
+	}
+      });
+    const double t2 = timed([&]() {
+	#pragma omp parallel num_threads(threads)
+	#pragma omp single
+	for (size_t i = 0; i != iters; i ++) {
+	  reentrant(lhs, rhs, result2);
+	}
+      });
+    report("région englobante", t1, result1 == reference,
+	   t2, result2 == reference);
+  }
+
+  // Contexte 3 : depuis plusieurs threads extérieurs à OpenMP (comme des
+  // threads TBB). apply ouvre une équipe par thread (surcharge),
+  // applyReentrant exécute les fusions l'une après l'autre dans l'équipe
+  // persistante.
+  {
+    const size_t callers = std::max(threads, 2);
+    std::vector< Vector > results1(callers, Vector(2 * size));
+    std::vector< Vector > results2(callers, Vector(2 * size));
+    const auto concurrent = [&](const Merge& merge,
+				std::vector< Vector >& results) {
+      std::vector< std::thread > workers;
+      for (size_t c = 0; c != callers; c ++) {
+	workers.emplace_back([&, c]() {
+	    for (size_t i = 0; i != iters; i ++) {
+	      merge(lhs, rhs, results[c]);
+	    }
+	  });
+      }
+      for (std::thread& worker : workers) {
+	worker.join();
+      }
+    };
+    const auto check = [&](const std::vector< Vector >& results) {
+      for (const Vector& result : results) {
+	if (result != reference) {
+	  return false;
+	}
+      }
+      return true;
+    };
+    const double t1 = timed([&]() { concurrent(forked, results1); });
+    const double t2 = timed([&]() { concurrent(reentrant, results2); });
+    report("threads extérieurs", t1, check(results1), t2, check(results2));
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,183 @@
+#include "SegmentedMerge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Synonyme du type des segments du lot.
+ */
+typedef merging::MergeSegment< std::vector< Type >::const_iterator,
+			       std::vector< Type >::const_iterator,
+			       std::vector< Type >::iterator > Segment;
+
+/**
+ * Chronomètre des traitements répétés du lot et affiche la durée, le speedup
+ * par rapport à la référence séquentielle et le verdict.
+ *
+ * @param[in] name - le nom de la version mesurée ;
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] seq - la durée de la référence (0 pour la référence elle-même) ;
+ * @param[in] run - un traitement du lot ;
+ * @param[in] check - le verdict, évalué après les répétitions.
+ * @return la durée totale en millisecondes.
+ */
+template< typename Run, typename Check >
+double
+measure(const std::string& name, const size_t& iters, const double& seq,
+	const Run& run, const Check& check) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    run();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  const double duration =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << duration << " msec." << std::endl;
+  if (seq != 0) {
+    std::cout << "\tSpeedup:\t" << Metrics::speedup(seq, duration)
+	      << std::endl;
+  }
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << check() << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+  return duration;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0]
+	      << " nb_iterations nb_segments taille_max" << std::endl;
+    std::cout << "\tUn segment sur 1000 est 100 fois plus grand que"
+	      << " taille_max." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 3 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 4) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations, du nombre de segments du
+  // lot et de la taille maximale d'un petit sous-conteneur.
+  size_t iters, count, size;
+  size_t* const parameters[] = { &iters, &count, &size };
+  for (int a = 1; a != argc; a ++) {
+    std::istringstream entree(argv[a]);
+    entree >> *parameters[a - 1];
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Relation d'ordre utilisée : inférieur ou égal à.
+  const auto comp = std::less_equal< const Type& >();
+  const int threads = omp_get_max_threads();
+
+  // Tailles des sous-conteneurs : uniformes entre 0 et size, sauf un
+  // segment sur 1000, 100 fois plus grand.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< size_t > length(0, size);
+  std::vector< size_t > sizes1(count), sizes2(count);
+  size_t total1 = 0, total2 = 0;
+  for (size_t s = 0; s != count; s ++) {
+    const size_t scale = s % 1000 == 999 ? 100 : 1;
+    sizes1[s] = scale * length(generator);
+    sizes2[s] = scale * length(generator);
+    total1 += sizes1[s];
+    total2 += sizes2[s];
+  }
+
+  // Sous-conteneurs triés, contigus dans deux grands conteneurs.
+  std::vector< Type > lhs(total1), rhs(total2);
+  std::uniform_int_distribution< Type > value(0, 1 << 20);
+  for (Type& x : lhs) {
+    x = value(generator);
+  }
+  for (Type& x : rhs) {
+    x = value(generator);
+  }
+  std::vector< Type > reference(total1 + total2), result(total1 + total2);
+  std::vector< Segment > segments(count);
+  for (size_t s = 0, o1 = 0, o2 = 0; s != count; s ++) {
+    std::sort(lhs.begin() + o1, lhs.begin() + o1 + sizes1[s]);
+    std::sort(rhs.begin() + o2, rhs.begin() + o2 + sizes2[s]);
+    segments[s] = Segment{ lhs.cbegin() + o1, lhs.cbegin() + o1 + sizes1[s],
+			   rhs.cbegin() + o2, rhs.cbegin() + o2 + sizes2[s],
+			   result.begin() + o1 + o2 };
+    std::merge(segments[s].first1, segments[s].last1,
+	       segments[s].first2, segments[s].last2,
+	       reference.begin() + o1 + o2);
+    o1 += sizes1[s];
+    o2 += sizes2[s];
+  }
+  const auto check = [&]() {
+    const bool ok = result == reference;
+    std::fill(result.begin(), result.end(), Type());
+    return ok;
+  };
+
+  std::cout << "--[ Lot: begin ]--" << std::endl;
+  std::cout << "\tSegments:\t" << count << std::endl;
+  std::cout << "\tÉléments:\t" << result.size() << std::endl;
+  std::cout << "\tThread(s):\t" << threads << std::endl;
+  std::cout << "--[ Lot: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  // Référence : chaque segment fusionné séquentiellement.
+  const double seq =
+    measure("MergeKernel par segment", iters, 0, [&]() {
+	for (const Segment& segment : segments) {
+	  merging::MergeKernel::apply(segment.first1, segment.last1,
+				      segment.first2, segment.last2,
+				      segment.result,
+				      comp);
+	}
+      }, check);
+
+  // Une région parallèle par segment.
+  measure("ParallelStableMerge par segment", iters, seq, [&]() {
+      for (const Segment& segment : segments) {
+	merging::ParallelStableMerge::apply(segment.first1, segment.last1,
+					    segment.first2, segment.last2,
+					    segment.result,
+					    comp,
+					    threads);
+      }
+    }, check);
+
+  // Une seule région parallèle pour tout le lot.
+  measure("SegmentedMerge", iters, seq, [&]() {
+      merging::SegmentedMerge::apply(segments, comp, threads);
+    }, check);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
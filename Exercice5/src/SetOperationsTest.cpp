@@ -0,0 +1,192 @@
+#include "ParallelSetOperations.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Synonyme du type des éléments des listes.
+ */
+typedef int Type;
+
+/**
+ * Synonyme du type des conteneurs.
+ */
+typedef std::vector< Type > Vector;
+
+/**
+ * Synonyme du type d'une opération : sources, cible, fin du résultat.
+ */
+typedef std::function< Vector::iterator(const Vector&, const Vector&,
+					Vector&) > Operation;
+
+/**
+ * Chronomètre une opération ensembliste séquentielle puis parallèle et
+ * compare leurs résultats.
+ *
+ * @param[in] name - le nom de l'opération ;
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] lhs - la première liste ;
+ * @param[in] rhs - la seconde liste ;
+ * @param[in] seq - l'opération séquentielle ;
+ * @param[in] par - l'opération parallèle.
+ */
+void
+compare(const std::string& name, const size_t& iters,
+	const Vector& lhs, const Vector& rhs,
+	const Operation& seq, const Operation& par) {
+  Vector expected(lhs.size() + rhs.size()), result(lhs.size() + rhs.size());
+  Vector::iterator expectedEnd, resultEnd;
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    expectedEnd = seq(lhs, rhs, expected);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  const double seqDuration =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    resultEnd = par(lhs, rhs, result);
+  }
+  stop = std::chrono::steady_clock::now();
+  const double parDuration =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  const bool ok =
+    expectedEnd - expected.begin() == resultEnd - result.begin() &&
+    std::equal(expected.begin(), expectedEnd, result.begin());
+
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tTaille:\t\t" << resultEnd - result.begin() << std::endl;
+  std::cout << "\tSéquentiel:\t" << seqDuration << " msec." << std::endl;
+  std::cout << "\tParallèle:\t" << parDuration << " msec." << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(seqDuration, parDuration)
+	    << std::endl;
+  std::cout << "\tVerdict:\t\t" << std::boolalpha << ok << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque liste.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Relation d'ordre utilisée : strictement inférieur à.
+  const auto comp = std::less< const Type& >();
+  const int threads = omp_get_max_threads();
+
+  // Deux listes triées de valeurs tirées dans [0, size) : elles se
+  // recouvrent et contiennent des doublons.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution(0, size);
+  Vector lhs(size), rhs(size);
+  for (Type& x : lhs) {
+    x = distribution(generator);
+  }
+  for (Type& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+
+  compare("set_union", iters, lhs, rhs,
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+				  c.begin(), comp);
+	  },
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return merging::ParallelSetOperations::setUnion(
+	      a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+	      threads);
+	  });
+
+  compare("set_intersection", iters, lhs, rhs,
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return std::set_intersection(a.begin(), a.end(),
+					 b.begin(), b.end(),
+					 c.begin(), comp);
+	  },
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return merging::ParallelSetOperations::setIntersection(
+	      a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+	      threads);
+	  });
+
+  compare("set_difference", iters, lhs, rhs,
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+				       c.begin(), comp);
+	  },
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return merging::ParallelSetOperations::setDifference(
+	      a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+	      threads);
+	  });
+
+  // Référence de l'union sans doublons : union puis std::unique.
+  compare("union sans doublons", iters, lhs, rhs,
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return std::unique(c.begin(),
+			       std::set_union(a.begin(), a.end(),
+					      b.begin(), b.end(),
+					      c.begin(), comp));
+	  },
+	  [&](const Vector& a, const Vector& b, Vector& c) {
+	    return merging::ParallelSetOperations::uniqueUnion(
+	      a.begin(), a.end(), b.begin(), b.end(), c.begin(), comp,
+	      threads);
+	  });
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
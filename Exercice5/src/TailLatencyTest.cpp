@@ -0,0 +1,197 @@
+#include "Exercice5Test.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <omp.h>
+
+/**
+ * Charge de fond : des threads calculant sans fin, jusqu'à leur arrêt, pour
+ * disputer les cœurs aux threads OpenMP.
+ */
+class BackgroundLoad {
+public:
+
+  /**
+   * Démarre la charge.
+   *
+   * @param[in] count - le nombre de threads de la charge.
+   */
+  explicit BackgroundLoad(const int& count) : stop(false) {
+    for (int t = 0; t < count; t ++) {
+      workers.emplace_back([this]() {
+	  volatile unsigned long x = 0;
+	  while (! stop.load(std::memory_order_relaxed)) {
+	    x = x * 6364136223846793005UL + 1;
+	  }
+	});
+    }
+  }
+
+  /**
+   * Arrête la charge.
+   */
+  ~BackgroundLoad() {
+    stop = true;
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+private:
+
+  std::atomic< bool > stop;              /** Drapeau d'arrêt. */
+  std::vector< std::thread > workers;    /** Threads de la charge. */
+
+};
+
+/**
+ * Affiche les quantiles des durées d'exécution.
+ *
+ * @param[in] name - le nom de la version mesurée ;
+ * @param[in,out] latencies - les durées d'exécution (triées en sortie) ;
+ * @param[in] ok - le verdict.
+ */
+void
+report(const std::string& name, std::vector< double >& latencies,
+       const bool& ok) {
+  std::sort(latencies.begin(), latencies.end());
+  const auto quantile = [&](const double& q) {
+    return latencies[static_cast< size_t >(q * (latencies.size() - 1))];
+  };
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tp50:\t\t" << quantile(0.50) << " msec." << std::endl;
+  std::cout << "\tp95:\t\t" << quantile(0.95) << " msec." << std::endl;
+  std::cout << "\tp99:\t\t" << quantile(0.99) << " msec." << std::endl;
+  std::cout << "\tmax:\t\t" << latencies.back() << " msec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << ok
+	    << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_threads_charge"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre de threads de
+  // la charge de fond.
+  size_t iters;
+  int load;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof() || iters == 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> load;
+    if (! entree || ! entree.eof() || load < 0) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Synonyme du type des éléments à fusionner.
+  typedef int Type;
+
+  // Relation d'ordre utilisée : inférieur ou égal à.
+  const auto comp = std::less_equal< const Type& >();
+
+  // Deux tableaux triés de valeurs aléatoires à fusionner.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution;
+  std::vector< Type > lhs(8 * 1024 * 1024), rhs(lhs.size() + 211);
+  for (auto& x : lhs) {
+    x = distribution(generator);
+  }
+  for (auto& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+  std::vector< Type > expected(lhs.size() + rhs.size());
+  std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	     expected.begin());
+  std::vector< Type > result(expected.size());
+
+  // init du scheduler d'openmp
+  const int threads = omp_get_max_threads();
+  std::cout << "Thread(s):\t" << threads << std::endl;
+  std::cout << "Charge:\t\t" << load << " thread(s)" << std::endl;
+  std::cout << std::endl;
+
+  // La charge de fond est active pendant toutes les mesures.
+  BackgroundLoad background(load);
+
+  // Durées d'exécution, fusion par fusion, du découpage en un fragment par
+  // thread.
+  std::vector< double > latencies(iters);
+  bool ok = true;
+  for (size_t i = 0; i != iters; i ++) {
+    std::fill(result.begin(), result.end(), 0);
+    const auto start = std::chrono::steady_clock::now();
+    merging::ParallelStableMerge::apply(lhs.begin(), lhs.end(),
+					rhs.begin(), rhs.end(),
+					result.begin(),
+					comp,
+					threads);
+    const auto stop = std::chrono::steady_clock::now();
+    latencies[i] =
+      std::chrono::duration< double, std::milli >(stop - start).count();
+    ok = ok && result == expected;
+  }
+  report("ParallelStableMerge::apply", latencies, ok);
+
+  // Durées d'exécution, fusion par fusion, du découpage en fragments à la
+  // taille du cache répartis dynamiquement.
+  ok = true;
+  for (size_t i = 0; i != iters; i ++) {
+    std::fill(result.begin(), result.end(), 0);
+    const auto start = std::chrono::steady_clock::now();
+    merging::ParallelStableMerge::applyDynamic(lhs.begin(), lhs.end(),
+					       rhs.begin(), rhs.end(),
+					       result.begin(),
+					       comp,
+					       threads);
+    const auto stop = std::chrono::steady_clock::now();
+    latencies[i] =
+      std::chrono::duration< double, std::milli >(stop - start).count();
+    ok = ok && result == expected;
+  }
+  report("ParallelStableMerge::applyDynamic", latencies, ok);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -1,10 +1,18 @@
 #ifndef Exercice5Test_hpp
 #define Exercice5Test_hpp
 
+#include "MergeKernel.hpp"
+#include "GallopingKernel.hpp"
+#include "KeyMergeKernel.hpp"
+#include "Numa.hpp"
+#include "OmpTeam.hpp"
 #include <functional>
 #include <algorithm>
+#include <iterator>
+#include <vector>
 #include <cmath>
 #include <omp.h>
+#include <unistd.h>
 
 namespace merging {
 
@@ -16,12 +24,77 @@ namespace merging {
    * @note L'implémentation proposée est celle de l'algorithme de fusion stable
    *   et parallèle décrite dans C. Siebert and J.L. Träff, "Perfectly 
    *   load-balanced, optimal, stable, parallel merge", CoRR, pp -1--1, 2013.
-   * @note Cette implémentation ne peut être employée qu'avec une relation
-   *   d'ordre de type <= ou >= mais pas < ou >.
+   * @note La relation d'ordre peut être de type <= ou >= ou stricte (< ou
+   *   >) : std::less, std::greater et les comparateurs enveloppés par
+   *   strict sont reconnus comme stricts (voir StrictOrder), tout autre
+   *   comparateur est supposé de type <= ou >=.
+   *   Dans les deux cas la fusion est stable : à valeurs égales, les
+   *   éléments du premier sous-conteneur précèdent ceux du second, aussi
+   *   bien entre les fragments (coRank) qu'au sein de chacun (le noyau
+   *   reçoit la relation stricte correspondante, voir leafOrder).
+   * @note Le noyau de fusion de chaque fragment est une politique : le
+   *   premier paramètre template de apply et applyDynamic (Leaf, MergeKernel
+   *   par défaut) désigne toute classe offrant la méthode statique apply de
+   *   MergeKernel, par exemple GallopingKernel.
+   * @note applyByKey fusionne des enregistrements rangés en colonnes : seules
+   *   les clés sont fusionnées, avec la permutation des enregistrements, puis
+   *   gather rassemble chaque colonne de charge utile (voir KeyMergeKernel).
+   * @note applyReentrant n'ouvre pas de région parallèle : ses fragments sont
+   *   des tâches de l'équipe englobante ou de l'équipe persistante OmpTeam.
    */
   class ParallelStableMerge {
   public:
 
+    /**
+     * Enveloppe désignant un comparateur quelconque (une lambda par exemple)
+     * comme une relation d'ordre stricte (voir strict).
+     */
+    template< typename Compare >
+    struct Strict {
+      Compare comp;
+      template< typename X, typename Y >
+      bool operator()(const X& x, const Y& y) const {
+	return comp(x, y);
+      }
+    };
+
+    /**
+     * Vrai si la relation d'ordre Compare est stricte (< ou >), faux si elle
+     * est de type <= ou >= (par défaut). Ce trait peut être spécialisé pour
+     * d'autres comparateurs stricts.
+     */
+    template< typename Compare >
+    struct StrictOrder {
+      static const bool value = false;
+    };
+
+    template< typename Compare >
+    struct StrictOrder< Strict< Compare > > {
+      static const bool value = true;
+    };
+
+    template< typename X >
+    struct StrictOrder< std::less< X > > {
+      static const bool value = true;
+    };
+
+    template< typename X >
+    struct StrictOrder< std::greater< X > > {
+      static const bool value = true;
+    };
+
+    /**
+     * Désigne un comparateur comme une relation d'ordre stricte.
+     *
+     * @param[in] comp - un comparateur binaire représentant une relation
+     *   d'ordre stricte.
+     * @return le comparateur enveloppé.
+     */
+    template< typename Compare >
+    static Strict< Compare > strict(const Compare& comp) {
+      return Strict< Compare >{ comp };
+    } // strict
+
     /**
      * Implémentation parallèle.
      *
@@ -41,7 +114,8 @@ namespace merging {
      * @return un itérateur repérant la fin de la zone de fusion dans le
      *   conteneur cible.
      */
-    template< typename InputRandomAccessIterator1,
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator,
 	      typename Compare >
@@ -78,9 +152,12 @@ namespace merging {
       #pragma omp parallel num_threads(threads)
 
       #pragma omp single 
-      for (OutputSize ir = 0; ir < threads; ir++) {
-        #pragma omp task firstprivate(ir)
+      for (OutputSize r = 0; r < threads; r++) {
+        #pragma omp task firstprivate(r)
         {
+        // Calcul du rang i_{r} du premier élément du fragment courant.
+        const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+
         // Calcul du couple (j_{r}, k_{r}) correspondant au 
         // rang i_{r} dans le conteneur cible.
         InputSize1 jr;
@@ -116,14 +193,15 @@ namespace merging {
 
           // Nous disposons de toutes les infos pour réaliser
           // la fusion dont le fragment courant est la cible.
-          // Cette opération est réalisée via l'algorithme
-          // merge de la bibliothèque standard.
-          std::merge(first1 + jr, 
-                     first1 + jrp1,
-                     first2 + kr, 
-                     first2 + krp1,
-                     result + ir,
-                     comp);
+          // Cette opération est réalisée via le noyau Leaf
+          // (par défaut MergeKernel, vectorisé lorsque c'est
+          // possible, sinon merge de la bibliothèque standard).
+          Leaf::apply(first1 + jr, 
+                      first1 + jrp1,
+                      first2 + kr, 
+                      first2 + krp1,
+                      result + ir,
+                      leafOrder(comp));
           } // omp task
         }// for
         
@@ -156,7 +234,8 @@ namespace merging {
      * @return un itérateur repérant la fin de la zone de fusion dans le
      *   conteneur cible.
      */
-    template< typename InputRandomAccessIterator1,
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
 	      typename InputRandomAccessIterator2,
 	      typename OutputRandomAccessIterator >
     static OutputRandomAccessIterator
@@ -175,7 +254,7 @@ namespace merging {
 
       // Fabriquer le comparateur less puis invoquer la méthode définie 
       // ci-dessus.
-      return apply(first1, 
+      return apply< Leaf >(first1, 
 		   last1,
 		   first2,
 		   last2,
@@ -185,8 +264,853 @@ namespace merging {
       
     } // apply
 
+    /**
+     * Implémentation parallèle déplaçant (au lieu de recopier) les éléments
+     * des deux sous-conteneurs vers le conteneur cible. Les sous-conteneurs
+     * sources sont consommés : leurs éléments sont laissés dans un état
+     * valide mais non spécifié.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     *
+     * @note coRank lit des éléments situés de part et d'autre des bornes de
+     *   chaque fragment, donc susceptibles d'être déplacés par le fragment
+     *   voisin. Tous les couples (j_{r}, k_{r}) sont donc calculés avant
+     *   qu'aucun élément ne soit déplacé.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const Compare& comp,
+	      const int& threads) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Tailles respectives des deux conteneurs à fusionner.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+
+      // Calcul de la taille du conteneur accueillant la fusion.
+      const OutputSize mpn = m + n;
+
+      // Calcul de la taille des fragments dans le conteneur cible de la fusion.
+      const OutputSize taille = std::ceil(mpn * 1.0 / threads);
+
+      // Couples (j_{r}, k_{r}) de tous les fragments, y compris la borne
+      // finale.
+      std::vector< InputSize1 > j(threads + 1);
+      std::vector< InputSize2 > k(threads + 1);
+
+      #pragma omp parallel num_threads(threads)
+      {
+        // Première phase : calcul des bornes de tous les fragments.
+        #pragma omp for schedule(static)
+        for (int r = 0; r <= threads; r++) {
+          const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+          coRank(ir, first1, m, first2, n, comp, j[r], k[r]);
+        } // barrière implicite
+
+        // Seconde phase : fusion par déplacement de chaque fragment.
+        #pragma omp for schedule(static)
+        for (int r = 0; r < threads; r++) {
+          const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+          MergeKernel::apply(std::make_move_iterator(first1 + j[r]),
+                             std::make_move_iterator(first1 + j[r + 1]),
+                             std::make_move_iterator(first2 + k[r]),
+                             std::make_move_iterator(first2 + k[r + 1]),
+                             result + ir,
+                             leafOrder(comp));
+        }
+      }
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + mpn;
+
+    } // applyMove
+
+    /**
+     * Implémentation parallèle déplaçant les éléments pour la relation
+     * d'ordre total inférieur ou égal.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou déplacer le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    applyMove(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const int& threads) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less_equal puis invoquer la méthode définie
+      // ci-dessus.
+      return applyMove(first1,
+		       last1,
+		       first2,
+		       last2,
+		       result,
+		       std::less_equal< const value_type& >(),
+		       threads);
+
+    } // applyMove
+
+    /**
+     * Implémentation parallèle sur-découpée : le conteneur cible est découpé
+     * en fragments de taille fixe, bien plus nombreux que les threads, que
+     * ceux-ci se répartissent dynamiquement (taskloop OpenMP). Un thread
+     * ralenti ou préempté ne retarde alors que les quelques fragments qu'il
+     * traite, les autres étant pris en charge par les threads disponibles.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles ;
+     * @param[in] grain - le nombre d'éléments de chaque fragment du conteneur
+     *   cible.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyDynamic(const InputRandomAccessIterator1& first1,
+		 const InputRandomAccessIterator1& last1,
+		 const InputRandomAccessIterator2& first2,
+		 const InputRandomAccessIterator2& last2,
+		 const OutputRandomAccessIterator& result,
+		 const Compare& comp,
+		 const int& threads,
+		 const size_t& grain) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Tailles respectives des deux conteneurs à fusionner.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+
+      // Calcul de la taille du conteneur accueillant la fusion.
+      const OutputSize mpn = m + n;
+
+      // Taille et nombre des fragments dans le conteneur cible de la fusion.
+      const OutputSize taille = std::max< OutputSize >(grain, 1);
+      const OutputSize fragments = (mpn + taille - 1) / taille;
+
+      // Les fragments sont distribués par paquets d'un seul fragment.
+      #pragma omp parallel num_threads(threads)
+      #pragma omp single
+      #pragma omp taskloop grainsize(1)
+      for (OutputSize r = 0; r < fragments; r++) {
+
+        // Rangs i_{r} et i_{r+1} délimitant le fragment courant.
+        const OutputSize ir = r * taille;
+        const OutputSize irp1 = std::min< OutputSize >(ir + taille, mpn);
+
+        // Couples (j_{r}, k_{r}) et (j_{r+1}, k_{r+1}) correspondants.
+        InputSize1 jr, jrp1;
+        InputSize2 kr, krp1;
+        coRank(ir, first1, m, first2, n, comp, jr, kr);
+        coRank(irp1, first1, m, first2, n, comp, jrp1, krp1);
+
+        // Fusion du fragment courant via le noyau Leaf.
+        Leaf::apply(first1 + jr,
+                    first1 + jrp1,
+                    first2 + kr,
+                    first2 + krp1,
+                    result + ir,
+                    leafOrder(comp));
+      }
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + mpn;
+
+    } // applyDynamic
+
+    /**
+     * Implémentation parallèle sur-découpée dont les fragments sont
+     * dimensionnés d'après le cache de niveau 2 : les deux sources et la
+     * cible d'un fragment y tiennent ensemble.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyDynamic(const InputRandomAccessIterator1& first1,
+		 const InputRandomAccessIterator1& last1,
+		 const InputRandomAccessIterator2& first2,
+		 const InputRandomAccessIterator2& last2,
+		 const OutputRandomAccessIterator& result,
+		 const Compare& comp,
+		 const int& threads) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      return applyDynamic< Leaf >(first1,
+			  last1,
+			  first2,
+			  last2,
+			  result,
+			  comp,
+			  threads,
+			  cacheGrain(sizeof(value_type)));
+
+    } // applyDynamic
+
+    /**
+     * Implémentation parallèle placée : le fragment r du conteneur cible est
+     * fusionné par le thread r de l'équipe, épinglé sur le nœud NUMA
+     * Numa::node(r, threads). Les conteneurs premier-touchés par
+     * Numa::firstTouch avec le même nombre de threads sont ainsi lus et
+     * écrits depuis le nœud qui possède leur mémoire.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     *
+     * @note Contrairement à apply, dont les fragments sont des tâches que
+     *   n'importe quel thread peut exécuter, l'attribution des fragments aux
+     *   threads est ici statique. L'affinité de chaque thread est rétablie à
+     *   la fin de la fusion.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator 
+    applyPinned(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& result,
+		const Compare& comp,
+		const int& threads) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Tailles respectives des deux conteneurs à fusionner.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+
+      // Calcul de la taille du conteneur accueillant la fusion.
+      const OutputSize mpn = m + n;
+
+      // Calcul de la taille des fragments dans le conteneur cible de la
+      // fusion, identique à celle de Numa::firstTouch.
+      const OutputSize taille = std::ceil(mpn * 1.0 / threads);
+
+      #pragma omp parallel num_threads(threads)
+      {
+        // Le fragment r est traité depuis le nœud qui le possède. L'équipe
+        // pouvant compter moins de threads que demandé (OMP_THREAD_LIMIT,
+        // OMP_DYNAMIC, région englobante), chaque thread parcourt les
+        // fragments de omp_get_num_threads() en omp_get_num_threads().
+        for (int r = omp_get_thread_num();
+             r < threads;
+             r += omp_get_num_threads()) {
+          const Numa::Pin pin(Numa::node(r, threads));
+
+          // Rangs i_{r} et i_{r+1} délimitant le fragment courant et couples
+          // (j_{r}, k_{r}) et (j_{r+1}, k_{r+1}) correspondants.
+          const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+          const OutputSize irp1 = std::min< OutputSize >(ir + taille, mpn);
+          InputSize1 jr, jrp1;
+          InputSize2 kr, krp1;
+          coRank(ir, first1, m, first2, n, comp, jr, kr);
+          coRank(irp1, first1, m, first2, n, comp, jrp1, krp1);
+
+          // Fusion du fragment courant via le noyau Leaf.
+          Leaf::apply(first1 + jr,
+                      first1 + jrp1,
+                      first2 + kr,
+                      first2 + krp1,
+                      result + ir,
+                      leafOrder(comp));
+        }
+      }
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + mpn;
+
+    } // applyPinned
+
+    /**
+     * Implémentation parallèle placée pour la relation d'ordre total
+     * inférieur ou égal.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    applyPinned(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& result,
+		const int& threads) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      return applyPinned< Leaf >(first1,
+			 last1,
+			 first2,
+			 last2,
+			 result,
+			 std::less_equal< const value_type& >(),
+			 threads);
+
+    } // applyPinned
+
+    /**
+     * Implémentation parallèle réentrante : contrairement à apply, aucune
+     * région parallèle n'est ouverte à chaque appel.
+     *   - Appelée depuis une région parallèle active (omp_in_parallel), elle
+     *     confie ses fragments, sous forme de tâches (taskloop), à l'équipe
+     *     englobante : la fusion n'est ni sérialisée (parallélisme imbriqué
+     *     désactivé) ni source de surcharge (équipe imbriquée).
+     *   - Appelée hors de toute région parallèle, elle confie ses fragments à
+     *     l'équipe persistante du processus (OmpTeam::shared), créée une fois
+     *     pour toutes. Les appels concurrents (threads TBB par exemple) y sont
+     *     exécutés l'un après l'autre au lieu d'ouvrir chacun une équipe.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de fragments (de tâches) souhaité.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    applyReentrant(const InputRandomAccessIterator1& first1,
+		   const InputRandomAccessIterator1& last1,
+		   const InputRandomAccessIterator2& first2,
+		   const InputRandomAccessIterator2& last2,
+		   const OutputRandomAccessIterator& result,
+		   const Compare& comp,
+		   const int& threads) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Tailles respectives des deux conteneurs à fusionner et du conteneur
+      // cible.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+      const OutputSize mpn = m + n;
+      if (mpn == 0) {
+	return result;
+      }
+
+      // Nombre et taille des fragments du conteneur cible.
+      const OutputSize slices =
+	std::max< OutputSize >(std::min< OutputSize >(threads, mpn), 1);
+      const OutputSize taille = (mpn + slices - 1) / slices;
+
+      // Un fragment par tâche ; le taskloop attend la fin de ses tâches
+      // (groupe de tâches implicite).
+      const auto spawn = [&]() {
+	#pragma omp taskloop num_tasks(slices)
+	for (OutputSize r = 0; r < slices; r ++) {
+	  const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+	  const OutputSize irp1 = std::min< OutputSize >(ir + taille, mpn);
+	  InputSize1 jr, jrp1;
+	  InputSize2 kr, krp1;
+	  coRank(ir, first1, m, first2, n, comp, jr, kr);
+	  coRank(irp1, first1, m, first2, n, comp, jrp1, krp1);
+	  Leaf::apply(first1 + jr,
+		      first1 + jrp1,
+		      first2 + kr,
+		      first2 + krp1,
+		      result + ir,
+		      leafOrder(comp));
+	}
+      };
+
+      // Équipe englobante ou, à défaut, équipe persistante.
+      if (slices == 1) {
+	Leaf::apply(first1, last1, first2, last2, result,
+		    leafOrder(comp));
+      }
+      else if (omp_in_parallel()) {
+	spawn();
+      }
+      else {
+	OmpTeam::shared().run(spawn);
+      }
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + mpn;
+
+    } // applyReentrant
+
+    /**
+     * Implémentation parallèle réentrante pour la relation d'ordre total
+     * inférieur ou égal.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière 
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le 
+     *   premier élément résultant de la fusion ;
+     * @param[in] threads - le nombre de fragments (de tâches) souhaité.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    applyReentrant(const InputRandomAccessIterator1& first1,
+		   const InputRandomAccessIterator1& last1,
+		   const InputRandomAccessIterator2& first2,
+		   const InputRandomAccessIterator2& last2,
+		   const OutputRandomAccessIterator& result,
+		   const int& threads) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      return applyReentrant< Leaf >(first1,
+			    last1,
+			    first2,
+			    last2,
+			    result,
+			    std::less_equal< const value_type& >(),
+			    threads);
+
+    } // applyReentrant
+
+    /**
+     * Fusion parallèle par clé (structure de tableaux, voir KeyMergeKernel) :
+     * les clés des deux sous-conteneurs sont fusionnées et la permutation des
+     * enregistrements est produite simultanément. Le découpage en fragments
+     * est celui d'apply, les co-rangs étant calculés sur les clés projetées.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second sous-conteneur ;
+     * @param[out] keys - un itérateur repérant la position où recopier la
+     *   première clé fusionnée ;
+     * @param[out] permutation - un itérateur repérant la position où écrire
+     *   le numéro (de 0 à m + n - 1) de l'enregistrement de la première clé
+     *   fusionnée ;
+     * @param[in] comp - un comparateur binaire régissant les clés projetées,
+     *   strict (voir StrictOrder) ou de type <= ou >= ;
+     * @param[in] projection - la projection appliquée aux clés avant
+     *   comparaison ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename KeyRandomAccessIterator,
+	      typename IndexRandomAccessIterator,
+	      typename Compare,
+	      typename Projection >
+    static void
+    applyByKey(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const KeyRandomAccessIterator& keys,
+	       const IndexRandomAccessIterator& permutation,
+	       const Compare& comp,
+	       const Projection& projection,
+	       const int& threads) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< KeyRandomAccessIterator > TraitsOutput;
+      typedef std::iterator_traits< IndexRandomAccessIterator > TraitsIndex;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+      typedef typename TraitsIndex::value_type Index;
+
+      // Précédence stable sur les clés, projetées ou non.
+      const auto before = [&](const auto& x, const auto& y) {
+	return precedes(comp, x, y);
+      };
+      const auto projected = [&](const auto& x, const auto& y) {
+	return precedes(comp, projection(x), projection(y));
+      };
+
+      // Tailles des sous-conteneurs et des fragments.
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+      const OutputSize mpn = m + n;
+      const OutputSize taille = std::ceil(mpn * 1.0 / threads);
+
+      // Boucle for parallèle sur les fragments.
+      #pragma omp parallel for num_threads(threads) schedule(static)
+      for (int r = 0; r < threads; r ++) {
+	const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+	const OutputSize irp1 = std::min< OutputSize >(ir + taille, mpn);
+	InputSize1 jr, jrp1;
+	InputSize2 kr, krp1;
+	coRank(ir, first1, m, first2, n, projected, jr, kr);
+	coRank(irp1, first1, m, first2, n, projected, jrp1, krp1);
+	KeyMergeKernel::apply(first1 + jr, first1 + jrp1,
+			      static_cast< Index >(jr),
+			      first2 + kr, first2 + krp1,
+			      static_cast< Index >(m + kr),
+			      keys + ir,
+			      permutation + ir,
+			      before,
+			      projection);
+      }
+
+    } // applyByKey
+
+    /**
+     * Fusion parallèle par clé sans projection.
+     *
+     * @param[in] first1 - un itérateur repérant la première clé du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant la première clé du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant la position située juste
+     *   derrière la dernière clé du second sous-conteneur ;
+     * @param[out] keys - un itérateur repérant la position où recopier la
+     *   première clé fusionnée ;
+     * @param[out] permutation - un itérateur repérant la position où écrire
+     *   le numéro de l'enregistrement de la première clé fusionnée ;
+     * @param[in] comp - un comparateur binaire régissant les clés, strict
+     *   (voir StrictOrder) ou de type <= ou >= ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename KeyRandomAccessIterator,
+	      typename IndexRandomAccessIterator,
+	      typename Compare >
+    static void
+    applyByKey(const InputRandomAccessIterator1& first1,
+	       const InputRandomAccessIterator1& last1,
+	       const InputRandomAccessIterator2& first2,
+	       const InputRandomAccessIterator2& last2,
+	       const KeyRandomAccessIterator& keys,
+	       const IndexRandomAccessIterator& permutation,
+	       const Compare& comp,
+	       const int& threads) {
+
+      applyByKey(first1, last1, first2, last2, keys, permutation, comp,
+		 KeyMergeKernel::Identity(), threads);
+
+    } // applyByKey
+
+    /**
+     * Rassemble en parallèle une colonne de charge utile selon la
+     * permutation produite par applyByKey.
+     *
+     * @param[in] first - un itérateur repérant le premier numéro de la
+     *   permutation ;
+     * @param[in] last - un itérateur repérant la position située juste
+     *   derrière le dernier numéro de la permutation ;
+     * @param[in] m - le nombre d'enregistrements du premier sous-conteneur ;
+     * @param[in] column1 - un itérateur repérant la colonne du premier
+     *   sous-conteneur ;
+     * @param[in] column2 - un itérateur repérant la colonne du second
+     *   sous-conteneur ;
+     * @param[out] result - un itérateur repérant la position où recopier la
+     *   première valeur rassemblée ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename IndexRandomAccessIterator,
+	      typename ColumnRandomAccessIterator1,
+	      typename ColumnRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static void
+    gather(const IndexRandomAccessIterator& first,
+	   const IndexRandomAccessIterator& last,
+	   const size_t& m,
+	   const ColumnRandomAccessIterator1& column1,
+	   const ColumnRandomAccessIterator2& column2,
+	   const OutputRandomAccessIterator& result,
+	   const int& threads) {
+
+      typedef std::iterator_traits< IndexRandomAccessIterator > Traits;
+      typedef typename Traits::difference_type Size;
+      typedef typename Traits::value_type Index;
+
+      const Size size = last - first;
+      const Size taille = std::ceil(size * 1.0 / threads);
+      #pragma omp parallel for num_threads(threads) schedule(static)
+      for (int r = 0; r < threads; r ++) {
+	const Size lo = std::min< Size >(r * taille, size);
+	const Size hi = std::min< Size >(lo + taille, size);
+	KeyMergeKernel::gather(first + lo, first + hi,
+			       static_cast< Index >(m),
+			       column1, column2,
+			       result + lo);
+      }
+
+    } // gather
+
   protected:
 
+    /**
+     * Relation d'ordre stricte transmise aux noyaux de fusion, dont la
+     * sémantique est celle de l'algorithme merge : un élément du second
+     * sous-conteneur y précède un élément du premier si et seulement si
+     * comp(second, premier) est vrai. Une relation stricte est transmise
+     * telle quelle (sans l'enveloppe Strict, afin que MergeKernel reconnaisse
+     * std::less et std::greater) ; une relation de type <= ou >= est remplacée par la
+     * relation stricte correspondante (std::less pour std::less_equal,
+     * std::greater pour std::greater_equal, afin de préserver la
+     * vectorisation de MergeKernel, !comp(y, x) sinon) pour que les
+     * éléments du premier sous-conteneur passent en premier.
+     */
+    template< typename Compare, bool Strict = StrictOrder< Compare >::value >
+    struct LeafOrder {
+      typedef Compare type;
+      static type make(const Compare& comp) {
+	return comp;
+      }
+    };
+
+    template< typename Compare >
+    struct LeafOrder< Strict< Compare >, true > {
+      typedef Compare type;
+      static type make(const Strict< Compare >& comp) {
+	return comp.comp;
+      }
+    };
+
+    template< typename Compare >
+    struct LeafOrder< Compare, false > {
+      struct type {
+	Compare comp;
+	template< typename X, typename Y >
+	bool operator()(const X& x, const Y& y) const {
+	  return ! comp(y, x);
+	}
+      };
+      static type make(const Compare& comp) {
+	return type{ comp };
+      }
+    };
+
+    template< typename X >
+    struct LeafOrder< std::less_equal< X >, false > {
+      typedef std::less< X > type;
+      static type make(const std::less_equal< X >&) {
+	return type();
+      }
+    };
+
+    template< typename X >
+    struct LeafOrder< std::greater_equal< X >, false > {
+      typedef std::greater< X > type;
+      static type make(const std::greater_equal< X >&) {
+	return type();
+      }
+    };
+
+    /**
+     * Retourne la relation d'ordre stricte à transmettre aux noyaux de
+     * fusion (voir LeafOrder).
+     *
+     * @param[in] comp - la relation d'ordre de la fusion.
+     * @return la relation d'ordre stricte correspondante.
+     */
+    template< typename Compare >
+    static typename LeafOrder< Compare >::type
+    leafOrder(const Compare& comp) {
+      return LeafOrder< Compare >::make(comp);
+    } // leafOrder
+
+    /**
+     * Vrai si un élément x du premier sous-conteneur précède un élément y du
+     * second dans la fusion stable : !comp(y, x) pour une relation stricte,
+     * comp(x, y) pour une relation de type <= ou >=.
+     *
+     * @param[in] comp - la relation d'ordre de la fusion ;
+     * @param[in] x - un élément du premier sous-conteneur ;
+     * @param[in] y - un élément du second sous-conteneur.
+     * @return vrai si x précède y.
+     */
+    template< typename Compare, typename X, typename Y >
+    static bool precedes(const Compare& comp, const X& x, const Y& y) {
+      if constexpr (StrictOrder< Compare >::value) {
+	return ! comp(y, x);
+      }
+      else {
+	return comp(x, y);
+      }
+    } // precedes
+
+    /**
+     * Retourne le nombre d'éléments d'un fragment tel que ses deux sources et
+     * sa cible (soit deux fois le fragment) tiennent dans le cache de niveau
+     * 2, ou dans 256 Ko si la taille de ce cache est inconnue.
+     *
+     * @param[in] elementSize - la taille des éléments à fusionner.
+     * @return le nombre d'éléments d'un fragment.
+     */
+    static size_t cacheGrain(const size_t& elementSize) {
+      long cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+      if (cache <= 0) {
+	cache = 256 * 1024;
+      }
+      return std::max< size_t >(cache / (2 * elementSize), 1024);
+    } // cacheGrain
+
     /**
      * Recherche dichotomique de la paire (j, k) représentant les rangs,
      * respectivement dans le premier et le second conteneur, des éléments
@@ -202,7 +1126,8 @@ namespace merging {
      *   conteneur ;
      * @param[in] n - le nombre d'éléments du second conteneur ;
      * @param[in] comp - un comparateur binaire représentant la relation d'ordre
-     *   total régissant les éléments des conteneurs àfusionner ;
+     *   total régissant les éléments des conteneurs àfusionner, stricte ou
+     *   de type <= (voir precedes) ;
      * @param[in,out] j - le rang du candidat potentiel dans le premier 
      *   conteneur ;
      * @param[in,out] k - le rang du candidat potentiel dans le second 
@@ -234,13 +1159,13 @@ namespace merging {
       bool active = true;
       InputSize2 klow = 0; 
       while (active) {
-	if (j > 0 && k < n && ! comp(*(a + j - 1), *(b + k))) {
+	if (j > 0 && k < n && ! precedes(comp, *(a + j - 1), *(b + k))) {
 	  const InputSize1 delta = std::ceil((j - jlow) / 2.0);
 	  klow = k;
 	  j = j - delta;
 	  k = k + delta;
 	}
-	else if (k > 0 && j < m && comp(*(a + j), *(b + k - 1))) {
+	else if (k > 0 && j < m && precedes(comp, *(a + j), *(b + k - 1))) {
 	  const InputSize2 delta = std::ceil((k - klow) / 2.0);
 	  jlow = j;
 	  j = j + delta;
@@ -0,0 +1,385 @@
+#ifndef ExternalMerge_hpp
+#define ExternalMerge_hpp
+
+#include "Exercice5Test.hpp"
+#include "ParallelMultiwayMerge.hpp"
+#include "HugePageArena.hpp"
+#include <functional>
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace merging {
+
+  /**
+   * @class MappedRun ExternalMerge.hpp
+   *
+   * Fichier binaire d'éléments de type T triés, projeté en lecture seule.
+   *
+   * @note La projection est annoncée séquentielle (MADV_SEQUENTIAL) ; les
+   *   fenêtres à venir sont préchargées (willNeed) et celles déjà consommées
+   *   rendues au système (release), de sorte que la mémoire résidente reste
+   *   bornée quelle que soit la taille du fichier.
+   */
+  template< typename T >
+  class MappedRun {
+  public:
+
+    /**
+     * Constructeur : ouvre et projette le fichier.
+     *
+     * @param[in] path - le chemin du fichier.
+     * @throw std::system_error si le fichier ne peut être ouvert ou projeté.
+     */
+    explicit MappedRun(const std::string& path)
+      : fd(open(path.c_str(), O_RDONLY)), data(nullptr), count(0) {
+      if (fd == -1) {
+	throw std::system_error(errno, std::generic_category(), path);
+      }
+      struct stat info;
+      if (fstat(fd, &info) != 0) {
+	const int error = errno;
+	close(fd);
+	throw std::system_error(error, std::generic_category(), path);
+      }
+      count = info.st_size / sizeof(T);
+      if (count != 0) {
+	void* const p = mmap(nullptr, count * sizeof(T), PROT_READ,
+			     MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED) {
+	  const int error = errno;
+	  close(fd);
+	  throw std::system_error(error, std::generic_category(), path);
+	}
+	data = static_cast< const T* >(p);
+	madvise(p, count * sizeof(T), MADV_SEQUENTIAL);
+      }
+    }
+
+    /**
+     * Destructeur : supprime la projection et ferme le fichier.
+     */
+    ~MappedRun() {
+      if (data != nullptr) {
+	munmap(const_cast< T* >(data), count * sizeof(T));
+      }
+      close(fd);
+    }
+
+    MappedRun(const MappedRun&) = delete;
+    MappedRun& operator=(const MappedRun&) = delete;
+
+    /**
+     * Retourne un pointeur sur le premier élément.
+     *
+     * @return le premier élément.
+     */
+    const T* begin() const {
+      return data;
+    }
+
+    /**
+     * Retourne un pointeur juste derrière le dernier élément.
+     *
+     * @return la fin du fichier.
+     */
+    const T* end() const {
+      return data + count;
+    }
+
+    /**
+     * Retourne le nombre d'éléments.
+     *
+     * @return le nombre d'éléments.
+     */
+    size_t size() const {
+      return count;
+    }
+
+    /**
+     * Annonce la lecture prochaine des éléments [from, to).
+     *
+     * @param[in] from - le rang du premier élément ;
+     * @param[in] to - le rang situé juste derrière le dernier élément.
+     */
+    void willNeed(const size_t& from, const size_t& to) const {
+      const std::pair< size_t, size_t > pages = outer(from, to);
+      if (pages.first < pages.second) {
+	madvise(const_cast< char* >(bytes()) + pages.first,
+		pages.second - pages.first, MADV_WILLNEED);
+      }
+    }
+
+    /**
+     * Rend au système les pages entièrement comprises dans [from, to) : elles
+     * ne seront plus lues.
+     *
+     * @param[in] from - le rang du premier élément ;
+     * @param[in] to - le rang situé juste derrière le dernier élément.
+     */
+    void release(const size_t& from, const size_t& to) const {
+      const long page = sysconf(_SC_PAGESIZE);
+      const size_t lo = (from * sizeof(T) + page - 1) / page * page;
+      const size_t hi = to * sizeof(T) / page * page;
+      if (lo < hi) {
+	madvise(const_cast< char* >(bytes()) + lo, hi - lo, MADV_DONTNEED);
+	posix_fadvise(fd, lo, hi - lo, POSIX_FADV_DONTNEED);
+      }
+    }
+
+  private:
+
+    /**
+     * Retourne l'adresse de la projection en octets.
+     *
+     * @return l'adresse de la projection.
+     */
+    const char* bytes() const {
+      return reinterpret_cast< const char* >(data);
+    }
+
+    /**
+     * Retourne les bornes, alignées sur les pages, des octets de [from, to).
+     *
+     * @param[in] from - le rang du premier élément ;
+     * @param[in] to - le rang situé juste derrière le dernier élément.
+     * @return les décalages du début et de la fin des pages concernées.
+     */
+    std::pair< size_t, size_t > outer(const size_t& from,
+				      const size_t& to) const {
+      const long page = sysconf(_SC_PAGESIZE);
+      return std::make_pair(from * sizeof(T) / page * page,
+			    std::min((to * sizeof(T) + page - 1) / page * page,
+				     count * sizeof(T)));
+    }
+
+    int fd;          /** Le descripteur du fichier. */
+    const T* data;   /** La projection. */
+    size_t count;    /** Le nombre d'éléments. */
+
+  }; // MappedRun
+
+  /**
+   * @class ExternalMerge ExternalMerge.hpp
+   *
+   * Fusion hors mémoire de k fichiers binaires triés d'éléments de type T
+   * vers un fichier binaire.
+   *
+   * @note Les fichiers sources sont projetés (MappedRun). La sortie est
+   *   produite par fenêtres de window éléments : les bornes de chaque fenêtre
+   *   dans les sources sont données par ParallelStableMerge::coRank (deux
+   *   sources) ou ParallelMultiwayMerge::multiCoRank (k sources), puis la
+   *   fenêtre est fusionnée en parallèle, chaque thread traitant un fragment
+   *   indépendant, dans un tampon à grandes pages (HugePageArena). Deux
+   *   tampons alternent : l'un est écrit par un unique appel write séquentiel
+   *   pendant que l'autre reçoit la fenêtre suivante. La mémoire employée est
+   *   donc de l'ordre de deux fenêtres, quelle que soit la taille des
+   *   fichiers.
+   * @note Avec deux sources, l'ordre est <= (ParallelStableMerge) ; avec k
+   *   sources, il est < et la fusion est stable (ParallelMultiwayMerge).
+   */
+  class ExternalMerge : protected ParallelStableMerge,
+			protected ParallelMultiwayMerge {
+  public:
+
+    /**
+     * Fusion hors mémoire.
+     *
+     * @param[in] inputs - les chemins des fichiers sources triés ;
+     * @param[in] output - le chemin du fichier cible, créé ou tronqué ;
+     * @param[in] threads - le nombre de threads disponibles ;
+     * @param[in] window - le nombre d'éléments d'une fenêtre.
+     * @return le nombre d'éléments écrits.
+     * @throw std::system_error en cas d'erreur d'entrée-sortie.
+     */
+    template< typename T >
+    static size_t apply(const std::vector< std::string >& inputs,
+			const std::string& output,
+			const int& threads,
+			const size_t& window) {
+      static_assert(std::is_trivially_copyable< T >::value,
+		    "ExternalMerge exige des éléments trivialement copiables");
+
+      // Projection des sources.
+      std::vector< std::unique_ptr< MappedRun< T > > > runs;
+      std::vector< std::pair< const T*, const T* > > sequences;
+      size_t total = 0;
+      for (const std::string& path : inputs) {
+	runs.emplace_back(new MappedRun< T >(path));
+	sequences.emplace_back(runs.back()->begin(), runs.back()->end());
+	total += runs.back()->size();
+      }
+      const size_t k = runs.size();
+
+      // Fichier cible.
+      const int fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd == -1) {
+	throw std::system_error(errno, std::generic_category(), output);
+      }
+
+      // Deux tampons de fenêtre à grandes pages.
+      const size_t size = std::max< size_t >(window, 1);
+      HugePageArena arena(2 * size * sizeof(T));
+      T* const buffers[2] = {
+	static_cast< T* >(arena.allocate(std::min(size, total) * sizeof(T),
+					 alignof(T))),
+	static_cast< T* >(arena.allocate(std::min(size, total) * sizeof(T),
+					 alignof(T)))
+      };
+
+      // Rangs de la fenêtre courante dans chaque source.
+      std::vector< size_t > lower(k, 0), upper(k);
+      std::future< void > writing;
+      try {
+	for (size_t w = 0, b = 0; w < total; w += size, b = 1 - b) {
+	  const size_t end = std::min(w + size, total);
+
+	  // Bornes de la fin de la fenêtre, préchargement de ses éléments.
+	  bounds(end, sequences, upper);
+	  for (size_t s = 0; s != k; s ++) {
+	    runs[s]->willNeed(lower[s], upper[s]);
+	  }
+
+	  // Fusion parallèle de la fenêtre dans le tampon libre : celui-ci a
+	  // été écrit deux fenêtres plus tôt, la précédente peut encore être
+	  // en cours d'écriture.
+	  std::vector< std::pair< const T*, const T* > > slice(k);
+	  for (size_t s = 0; s != k; s ++) {
+	    slice[s] = std::make_pair(sequences[s].first + lower[s],
+				      sequences[s].first + upper[s]);
+	  }
+	  mergeWindow(slice, buffers[b], threads);
+
+	  // Écriture de la fenêtre pendant la fusion de la suivante.
+	  if (writing.valid()) {
+	    writing.get();
+	  }
+	  writing = std::async(std::launch::async, writeAll, fd,
+			       reinterpret_cast< const char* >(buffers[b]),
+			       (end - w) * sizeof(T));
+
+	  // Les éléments consommés ne seront plus lus.
+	  for (size_t s = 0; s != k; s ++) {
+	    runs[s]->release(lower[s], upper[s]);
+	  }
+	  lower = upper;
+	}
+	if (writing.valid()) {
+	  writing.get();
+	}
+      }
+      catch (...) {
+	if (writing.valid()) {
+	  writing.wait();
+	}
+	close(fd);
+	throw;
+      }
+      if (close(fd) != 0) {
+	throw std::system_error(errno, std::generic_category(), output);
+      }
+      return total;
+    } // apply
+
+  protected:
+
+    /**
+     * Calcule les rangs, dans chaque source, des éléments précédant le rang
+     * i du fichier cible.
+     *
+     * @param[in] i - le rang dans le fichier cible ;
+     * @param[in] sequences - les sources ;
+     * @param[out] j - les rangs dans chaque source.
+     */
+    template< typename T >
+    static void bounds(const size_t& i,
+		       const std::vector< std::pair< const T*, const T* > >&
+		         sequences,
+		       std::vector< size_t >& j) {
+      if (sequences.size() == 1) {
+	j[0] = i;
+      }
+      else if (sequences.size() == 2) {
+	const std::ptrdiff_t m = sequences[0].second - sequences[0].first;
+	const std::ptrdiff_t n = sequences[1].second - sequences[1].first;
+	std::ptrdiff_t j0, k0;
+	coRank(static_cast< std::ptrdiff_t >(i),
+	       sequences[0].first, m, sequences[1].first, n,
+	       std::less_equal< const T& >(), j0, k0);
+	j[0] = j0;
+	j[1] = k0;
+      }
+      else {
+	std::vector< std::ptrdiff_t > ranks;
+	multiCoRank(static_cast< std::ptrdiff_t >(i), sequences,
+		    std::less< const T& >(), ranks);
+	std::copy(ranks.begin(), ranks.end(), j.begin());
+      }
+    } // bounds
+
+    /**
+     * Fusionne en parallèle une fenêtre des sources.
+     *
+     * @param[in] slice - les éléments de la fenêtre dans chaque source ;
+     * @param[out] result - le tampon cible ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename T >
+    static void mergeWindow(const std::vector< std::pair< const T*,
+					                  const T* > >& slice,
+			    T* const result,
+			    const int& threads) {
+      if (slice.size() == 1) {
+	std::copy(slice[0].first, slice[0].second, result);
+      }
+      else if (slice.size() == 2) {
+	ParallelStableMerge::apply(slice[0].first, slice[0].second,
+				   slice[1].first, slice[1].second,
+				   result,
+				   std::less_equal< const T& >(),
+				   threads);
+      }
+      else if (slice.size() > 2) {
+	ParallelMultiwayMerge::apply(slice, result, std::less< const T& >(),
+				     threads);
+      }
+    } // mergeWindow
+
+    /**
+     * Écrit entièrement un tampon dans un fichier.
+     *
+     * @param[in] fd - le descripteur du fichier ;
+     * @param[in] data - le tampon ;
+     * @param[in] bytes - le nombre d'octets à écrire.
+     * @throw std::system_error en cas d'erreur d'écriture.
+     */
+    static void writeAll(const int fd, const char* data, size_t bytes) {
+      while (bytes != 0) {
+	const ssize_t written = write(fd, data, bytes);
+	if (written < 0) {
+	  if (errno == EINTR) {
+	    continue;
+	  }
+	  throw std::system_error(errno, std::generic_category(), "write");
+	}
+	data += written;
+	bytes -= written;
+      }
+    } // writeAll
+
+  }; // ExternalMerge
+
+} // merging
+
+#endif
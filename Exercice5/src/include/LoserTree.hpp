@@ -0,0 +1,153 @@
+#ifndef LoserTree_hpp
+#define LoserTree_hpp
+
+#include <vector>
+#include <cstddef>
+
+namespace merging {
+
+  /**
+   * @class LoserTree LoserTree.hpp
+   *
+   * Arbre des perdants permettant de fusionner séquentiellement k
+   * sous-conteneurs triés avec log2(k) comparaisons par élément produit.
+   *
+   * @note Les feuilles sont les sous-conteneurs (d'indices k à 2k - 1), chaque
+   *   noeud interne retient le perdant du match correspondant et la racine
+   *   (d'indice 0) le vainqueur global. À égalité, le sous-conteneur de plus
+   *   petit indice l'emporte : la fusion est donc stable. Un sous-conteneur
+   *   épuisé perd contre tous les autres.
+   */
+  template< typename InputRandomAccessIterator,
+	    typename Compare >
+  class LoserTree {
+  public:
+
+    /**
+     * Constructeur.
+     *
+     * @param[in] k - le nombre de sous-conteneurs à fusionner ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     */
+    LoserTree(const size_t& k, const Compare& comp)
+      : _k(k), _comp(comp), _current(k), _last(k), _tree(k == 0 ? 1 : k) {
+    }
+
+    /**
+     * Fusionne les sous-conteneurs [first[s], last[s]) pour s de 0 à k - 1.
+     *
+     * @param[in] first - les itérateurs repérant le premier élément de chaque
+     *   sous-conteneur ;
+     * @param[in] last - les itérateurs repérant l'élément situé juste derrière
+     *   le dernier élément de chaque sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename OutputRandomAccessIterator >
+    OutputRandomAccessIterator
+    merge(const std::vector< InputRandomAccessIterator >& first,
+	  const std::vector< InputRandomAccessIterator >& last,
+	  OutputRandomAccessIterator result) {
+
+      // Nombre total d'éléments à produire.
+      size_t total = 0;
+      for (size_t s = 0; s != _k; s ++) {
+	_current[s] = first[s];
+	_last[s] = last[s];
+	total += last[s] - first[s];
+      }
+      if (total == 0) {
+	return result;
+      }
+
+      // Construction de l'arbre, puis extractions successives du vainqueur
+      // suivies du rejeu des matchs de sa feuille jusqu'à la racine.
+      build();
+      for (size_t i = 0; i != total; i ++) {
+	size_t winner = _tree[0];
+	*result = *_current[winner];
+	++ result;
+	++ _current[winner];
+	for (size_t node = (winner + _k) / 2; node > 0; node /= 2) {
+	  if (beats(_tree[node], winner)) {
+	    std::swap(_tree[node], winner);
+	  }
+	}
+	_tree[0] = winner;
+      }
+      return result;
+
+    } // merge
+
+  protected:
+
+    /**
+     * Détermine si le sous-conteneur a l'emporte sur le sous-conteneur b.
+     *
+     * @param[in] a - l'indice du premier sous-conteneur ;
+     * @param[in] b - l'indice du second sous-conteneur.
+     * @return vrai si l'élément de tête de a doit être produit avant celui
+     *   de b.
+     */
+    bool beats(const size_t& a, const size_t& b) const {
+      if (_current[a] == _last[a]) {
+	return false;
+      }
+      if (_current[b] == _last[b]) {
+	return true;
+      }
+      if (_comp(*_current[b], *_current[a])) {
+	return false;
+      }
+      if (_comp(*_current[a], *_current[b])) {
+	return true;
+      }
+      return a < b;
+    } // beats
+
+    /**
+     * Joue tous les matchs initiaux, des feuilles vers la racine.
+     */
+    void build() {
+      std::vector< size_t > winners(2 * _k);
+      for (size_t s = 0; s != _k; s ++) {
+	winners[_k + s] = s;
+      }
+      for (size_t node = _k - 1; node > 0; node --) {
+	const size_t a = winners[2 * node];
+	const size_t b = winners[2 * node + 1];
+	if (beats(a, b)) {
+	  winners[node] = a;
+	  _tree[node] = b;
+	}
+	else {
+	  winners[node] = b;
+	  _tree[node] = a;
+	}
+      }
+      _tree[0] = _k == 1 ? 0 : winners[1];
+    } // build
+
+    /** Le nombre de sous-conteneurs. */
+    const size_t _k;
+
+    /** La relation d'ordre. */
+    const Compare _comp;
+
+    /** La tête courante de chaque sous-conteneur. */
+    std::vector< InputRandomAccessIterator > _current;
+
+    /** La fin de chaque sous-conteneur. */
+    std::vector< InputRandomAccessIterator > _last;
+
+    /** Le vainqueur global (indice 0) puis le perdant de chaque noeud. */
+    std::vector< size_t > _tree;
+
+  }; // LoserTree
+
+} // merging
+
+#endif
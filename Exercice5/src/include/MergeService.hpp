@@ -0,0 +1,331 @@
+#ifndef MergeService_hpp
+#define MergeService_hpp
+
+#include "Exercice5Test.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <cstddef>
+
+namespace merging {
+
+  /**
+   * @class MergeService MergeService.hpp
+   *
+   * Service de fusion à faible latence : une équipe fixe de threads, créée
+   * une fois pour toutes, exécute les fusions de ParallelStableMerge sans
+   * fork/join OpenMP ni création de tâches à chaque appel.
+   *
+   * Chaque fusion est publiée dans un descripteur sans verrou : le thread
+   * appelant y écrit la fonction de fragment et son contexte puis incrémente
+   * une époque (publication release). Les threads de l'équipe attendent une
+   * nouvelle époque en l'observant activement pendant un nombre borné
+   * d'itérations, puis s'endorment sur une variable condition. Le fragment 0
+   * est fusionné par l'appelant, le fragment r par le thread r ; l'appelant
+   * attend ensuite (activement) le décompte des fragments restants.
+   *
+   * @note Les fragments sont délimités par co-rangs, comme dans apply : la
+   *   relation d'ordre peut être stricte ou de type <= ou >=, la fusion est
+   *   stable et le comparateur ne doit pas lever d'exception.
+   * @note Les appels concurrents d'un même service sont exécutés l'un après
+   *   l'autre.
+   */
+  class MergeService : protected ParallelStableMerge {
+  public:
+
+    /**
+     * Constructeur : démarre l'équipe.
+     *
+     * @param[in] threads - le nombre de fragments de chaque fusion, appelant
+     *   compris (l'équipe compte threads - 1 threads) ;
+     * @param[in] spins - le nombre d'itérations d'attente active d'un thread
+     *   de l'équipe avant qu'il ne s'endorme, ramené à 0 lorsque l'équipe
+     *   compte plus de threads que la machine de cœurs (l'attente active
+     *   priverait alors de cœur les threads qui travaillent).
+     */
+    explicit MergeService(const int& threads, const size_t& spins = 1 << 14)
+      : threads(std::max(threads, 1)),
+	spins(static_cast< unsigned >(std::max(threads, 1)) >
+	      std::thread::hardware_concurrency() ? 0 : spins),
+	stop(false),
+	epoch(0), remaining(0), sleepers(0), busy(false) {
+      for (int id = 1; id < this->threads; id ++) {
+	team.emplace_back([this, id]() { work(id); });
+      }
+    }
+
+    /**
+     * Destructeur : arrête l'équipe.
+     */
+    ~MergeService() {
+      {
+	std::lock_guard< std::mutex > lock(mutex);
+	stop.store(true);
+	epoch.fetch_add(1);
+      }
+      wake.notify_all();
+      for (std::thread& worker : team) {
+	worker.join();
+      }
+    }
+
+    MergeService(const MergeService&) = delete;
+    MergeService& operator=(const MergeService&) = delete;
+
+    /**
+     * Retourne le nombre de fragments de chaque fusion.
+     *
+     * @return le nombre de threads, appelant compris.
+     */
+    int size() const {
+      return threads;
+    }
+
+    /**
+     * Fusion parallèle par l'équipe.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp) {
+      typedef Job< InputRandomAccessIterator1,
+		   InputRandomAccessIterator2,
+		   OutputRandomAccessIterator,
+		   Compare > Context;
+
+      // Sans équipe, la fusion est séquentielle.
+      const auto mpn = (last1 - first1) + (last2 - first2);
+      if (threads == 1) {
+	Leaf::apply(first1, last1, first2, last2, result, leafOrder(comp));
+	return result + mpn;
+      }
+
+      // Un seul appel à la fois.
+      while (busy.exchange(true, std::memory_order_acquire)) {
+	relax();
+      }
+
+      // Publication du descripteur puis de la nouvelle époque.
+      const Context context = { first1, last1, first2, last2, result, &comp };
+      descriptor.slice = &slice< Leaf, Context >;
+      descriptor.context = &context;
+      remaining.store(threads - 1, std::memory_order_relaxed);
+      epoch.fetch_add(1);
+
+      // Réveil des threads endormis, s'il y en a.
+      if (sleepers.load() != 0) {
+	std::lock_guard< std::mutex > lock(mutex);
+	wake.notify_all();
+      }
+
+      // L'appelant fusionne le premier fragment puis attend les autres.
+      slice< Leaf, Context >(&context, 0, threads);
+      for (size_t s = 0;
+	   remaining.load(std::memory_order_acquire) != 0;
+	   s ++) {
+	if (s < spins) {
+	  relax();
+	}
+	else {
+	  std::this_thread::yield();
+	}
+      }
+
+      busy.store(false, std::memory_order_release);
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + mpn;
+
+    } // apply
+
+    /**
+     * Fusion parallèle par l'équipe pour la relation d'ordre total inférieur
+     * ou égal.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur concerné par la fusion ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur concerné par la fusion ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    OutputRandomAccessIterator
+    apply(const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      return apply< Leaf >(first1,
+			   last1,
+			   first2,
+			   last2,
+			   result,
+			   std::less_equal< const value_type& >());
+
+    } // apply
+
+  private:
+
+    /**
+     * Contexte d'une fusion : ses arguments.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    struct Job {
+      typedef typename std::iterator_traits< InputRandomAccessIterator1 >
+	::difference_type InputSize1;
+      typedef typename std::iterator_traits< InputRandomAccessIterator2 >
+	::difference_type InputSize2;
+      typedef typename std::iterator_traits< OutputRandomAccessIterator >
+	::difference_type OutputSize;
+      InputRandomAccessIterator1 first1, last1;
+      InputRandomAccessIterator2 first2, last2;
+      OutputRandomAccessIterator result;
+      const Compare* comp;
+    };
+
+    /**
+     * Descripteur de la fusion courante, écrit par l'appelant avant
+     * l'incrémentation de l'époque.
+     */
+    struct Descriptor {
+      void (*slice)(const void*, int, int);    /** Fonction de fragment. */
+      const void* context;                     /** Son contexte (un Job). */
+    };
+
+    /**
+     * Fusionne un fragment du conteneur cible.
+     *
+     * @param[in] context - le contexte de la fusion (un Job) ;
+     * @param[in] r - le numéro du fragment ;
+     * @param[in] slices - le nombre de fragments.
+     */
+    template< typename Leaf, typename Context >
+    static void slice(const void* context, int r, int slices) {
+      typedef typename Context::InputSize1 InputSize1;
+      typedef typename Context::InputSize2 InputSize2;
+      typedef typename Context::OutputSize OutputSize;
+      const Context& job = *static_cast< const Context* >(context);
+      const InputSize1 m = job.last1 - job.first1;
+      const InputSize2 n = job.last2 - job.first2;
+      const OutputSize mpn = m + n;
+      const OutputSize taille = (mpn + slices - 1) / slices;
+      const OutputSize ir = std::min< OutputSize >(r * taille, mpn);
+      const OutputSize irp1 = std::min< OutputSize >(ir + taille, mpn);
+      InputSize1 jr, jrp1;
+      InputSize2 kr, krp1;
+      coRank(ir, job.first1, m, job.first2, n, *job.comp, jr, kr);
+      coRank(irp1, job.first1, m, job.first2, n, *job.comp, jrp1, krp1);
+      Leaf::apply(job.first1 + jr,
+		  job.first1 + jrp1,
+		  job.first2 + kr,
+		  job.first2 + krp1,
+		  job.result + ir,
+		  leafOrder(*job.comp));
+    } // slice
+
+    /**
+     * Corps d'un thread de l'équipe.
+     *
+     * @param[in] id - le numéro du thread, qui est celui de son fragment.
+     */
+    void work(const int& id) {
+      for (size_t seen = 0; ; ) {
+
+	// Attente active puis sommeil jusqu'à la prochaine époque.
+	size_t current = epoch.load(std::memory_order_acquire);
+	for (size_t s = 0; current == seen && s < spins; s ++) {
+	  relax();
+	  current = epoch.load(std::memory_order_acquire);
+	}
+	if (current == seen) {
+	  std::unique_lock< std::mutex > lock(mutex);
+	  sleepers.fetch_add(1);
+	  wake.wait(lock, [&]() {
+	      current = epoch.load();
+	      return current != seen;
+	    });
+	  sleepers.fetch_sub(1);
+	}
+	seen = current;
+	if (stop.load(std::memory_order_relaxed)) {
+	  return;
+	}
+
+	// Fragment id de la fusion publiée.
+	descriptor.slice(descriptor.context, id, threads);
+	remaining.fetch_sub(1, std::memory_order_release);
+      }
+    } // work
+
+    /**
+     * Pause d'une itération d'attente active.
+     */
+    static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#endif
+    }
+
+    const int threads;                          /** Fragments par fusion. */
+    const size_t spins;                         /** Budget d'attente active. */
+    Descriptor descriptor;                      /** La fusion publiée. */
+    std::atomic< bool > stop;                   /** Demande d'arrêt. */
+    alignas(64) std::atomic< size_t > epoch;    /** Numéro de la fusion. */
+    alignas(64) std::atomic< int > remaining;   /** Fragments en cours. */
+    alignas(64) std::atomic< int > sleepers;    /** Threads endormis. */
+    alignas(64) std::atomic< bool > busy;       /** Service occupé. */
+    std::mutex mutex;                           /** Verrou du sommeil. */
+    std::condition_variable wake;               /** Réveil de l'équipe. */
+    std::vector< std::thread > team;            /** L'équipe. */
+
+  }; // MergeService
+
+} // merging
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef Numa_hpp
+#define Numa_hpp
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <omp.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace merging {
+
+  /**
+   * @class Numa Numa.hpp
+   *
+   * Topologie NUMA de la machine et placement des threads : le fragment r
+   * (sur threads) d'un conteneur est associé au nœud r * nodes() / threads,
+   * les fragments consécutifs partageant donc le même nœud. Un conteneur
+   * premier-touché par firstTouch puis fusionné par
+   * ParallelStableMerge::applyPinned avec le même nombre de threads voit
+   * ainsi chacun de ses fragments traité sur le nœud qui en possède la
+   * mémoire (politique du premier accès de Linux).
+   *
+   * @note Les nœuds sont lus dans /sys/devices/system/node, sans dépendre de
+   *   libnuma ; seuls les processeurs autorisés au processus sont retenus.
+   *   La variable d'environnement PARA_NUMA_NODES impose un nombre de nœuds
+   *   fictifs, obtenus en répartissant les processeurs autorisés en autant
+   *   de groupes contigus : les placements peuvent ainsi être éprouvés sur
+   *   une machine à un seul nœud, sans effet sur la mémoire.
+   * @note Avec un seul nœud, aucun thread n'est épinglé.
+   */
+  class Numa {
+  public:
+
+    /**
+     * Retourne le nombre de nœuds.
+     *
+     * @return le nombre de nœuds, au moins 1.
+     */
+    static int nodes() {
+      return static_cast< int >(topology().size());
+    } // nodes
+
+    /**
+     * Retourne le nœud associé à un fragment.
+     *
+     * @param[in] r - le rang du fragment ;
+     * @param[in] threads - le nombre de fragments (et de threads).
+     * @return le nœud du fragment.
+     */
+    static int node(const int& r, const int& threads) {
+      return static_cast< int >(static_cast< long >(r) * nodes() / threads);
+    } // node
+
+    /**
+     * @class Pin Numa.hpp
+     *
+     * Épingle le thread courant sur les processeurs d'un nœud durant sa
+     * portée, puis rétablit son affinité antérieure.
+     */
+    class Pin {
+    public:
+
+      /**
+       * Constructeur : épingle le thread courant.
+       *
+       * @param[in] node - le nœud.
+       */
+      explicit Pin(const int& node) : pinned(false) {
+#if defined(__linux__)
+	if (nodes() > 1 &&
+	    sched_getaffinity(0, sizeof(saved), &saved) == 0) {
+	  pinned = sched_setaffinity(0, sizeof(cpu_set_t),
+				     &topology()[node]) == 0;
+	}
+#else
+	(void) node;
+#endif
+      }
+
+      /**
+       * Destructeur : rétablit l'affinité du thread courant.
+       */
+      ~Pin() {
+#if defined(__linux__)
+	if (pinned) {
+	  sched_setaffinity(0, sizeof(saved), &saved);
+	}
+#endif
+      }
+
+      Pin(const Pin&) = delete;
+      Pin& operator=(const Pin&) = delete;
+
+    private:
+
+      bool pinned;       /** Vrai si le thread a été épinglé. */
+#if defined(__linux__)
+      cpu_set_t saved;   /** L'affinité antérieure. */
+#endif
+
+    }; // Pin
+
+    /**
+     * Premier accès parallèle à un conteneur non initialisé (voir
+     * FirstTouchAllocator) : le fragment r, découpé comme le conteneur cible
+     * de ParallelStableMerge::applyPinned (taille ceil(size / threads)), est
+     * initialisé à value_type() par un thread épinglé sur son nœud, qui en
+     * possède dès lors les pages.
+     *
+     * @param[in] first - un itérateur repérant le premier élément ;
+     * @param[in] last - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément ;
+     * @param[in] threads - le nombre de threads de la fusion à venir.
+     *
+     * @note Pour les sources, ce découpage proportionnel approche celui des
+     *   co-rangs (j_{r} ~ r * m / threads), exact lorsque les valeurs des
+     *   deux sources sont uniformément entrelacées.
+     */
+    template< typename RandomAccessIterator >
+    static void firstTouch(const RandomAccessIterator& first,
+			   const RandomAccessIterator& last,
+			   const int& threads) {
+      typedef std::iterator_traits< RandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+      typedef typename Traits::difference_type Size;
+      const Size size = last - first;
+      const Size taille = std::ceil(size * 1.0 / threads);
+      #pragma omp parallel num_threads(threads)
+      {
+	// L'équipe peut compter moins de threads que demandé : chaque thread
+	// parcourt les fragments de omp_get_num_threads() en
+	// omp_get_num_threads().
+	for (int r = omp_get_thread_num();
+	     r < threads;
+	     r += omp_get_num_threads()) {
+	  const Pin pin(node(r, threads));
+	  const Size lo = std::min< Size >(r * taille, size);
+	  const Size hi = std::min< Size >(lo + taille, size);
+	  std::fill(first + lo, first + hi, value_type());
+	}
+      }
+    } // firstTouch
+
+  protected:
+
+#if defined(__linux__)
+    /** Type synonyme : les processeurs de chaque nœud. */
+    typedef std::vector< cpu_set_t > Topology;
+#else
+    typedef std::vector< int > Topology;
+#endif
+
+    /**
+     * Retourne les processeurs de chaque nœud, lus lors du premier appel.
+     *
+     * @return les processeurs de chaque nœud.
+     */
+    static const Topology& topology() {
+      static const Topology nodes = load();
+      return nodes;
+    } // topology
+
+    /**
+     * Construit la topologie : nœuds fictifs si PARA_NUMA_NODES est défini,
+     * nœuds de /sys/devices/system/node sinon, un seul nœud à défaut.
+     *
+     * @return les processeurs de chaque nœud.
+     */
+    static Topology load() {
+#if defined(__linux__)
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+	return Topology(1, allowed);
+      }
+
+      // Nœuds fictifs : groupes contigus de processeurs autorisés, un même
+      // processeur pouvant servir plusieurs groupes s'ils sont trop peu.
+      const char* const forced = std::getenv("PARA_NUMA_NODES");
+      if (forced != nullptr && std::atoi(forced) > 0) {
+	const long groups = std::atoi(forced);
+	std::vector< int > cpus;
+	for (int c = 0; c != CPU_SETSIZE; c ++) {
+	  if (CPU_ISSET(c, &allowed)) {
+	    cpus.push_back(c);
+	  }
+	}
+	const long count = cpus.size();
+	Topology nodes(groups);
+	for (long g = 0; g != groups; g ++) {
+	  CPU_ZERO(&nodes[g]);
+	  const long lo = g * count / groups;
+	  const long hi = std::max((g + 1) * count / groups, lo + 1);
+	  for (long c = lo; c != hi && c < count; c ++) {
+	    CPU_SET(cpus[c], &nodes[g]);
+	  }
+	}
+	return nodes;
+      }
+
+      // Nœuds réels : leurs processeurs autorisés, les nœuds sans
+      // processeur (mémoire seule) étant ignorés.
+      Topology nodes;
+      for (int n = 0; ; n ++) {
+	std::ifstream stream("/sys/devices/system/node/node" +
+			     std::to_string(n) + "/cpulist");
+	std::string list;
+	if (! std::getline(stream, list)) {
+	  break;
+	}
+	cpu_set_t cpus = parse(list);
+	CPU_AND(&cpus, &cpus, &allowed);
+	if (CPU_COUNT(&cpus) != 0) {
+	  nodes.push_back(cpus);
+	}
+      }
+      if (nodes.empty()) {
+	nodes.push_back(allowed);
+      }
+      return nodes;
+#else
+      return Topology(1, 0);
+#endif
+    } // load
+
+#if defined(__linux__)
+    /**
+     * Décode une liste de processeurs au format du noyau, par exemple
+     * « 0-3,8-11 ».
+     *
+     * @param[in] list - la liste.
+     * @return l'ensemble de processeurs correspondant.
+     */
+    static cpu_set_t parse(const std::string& list) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      std::istringstream entree(list);
+      std::string range;
+      while (std::getline(entree, range, ',')) {
+	const size_t dash = range.find('-');
+	const int lo = std::atoi(range.substr(0, dash).c_str());
+	const int hi = dash == std::string::npos ?
+	  lo : std::atoi(range.substr(dash + 1).c_str());
+	for (int c = lo; c <= hi && c < CPU_SETSIZE; c ++) {
+	  CPU_SET(c, &cpus);
+	}
+      }
+      return cpus;
+    } // parse
+#endif
+
+  }; // Numa
+
+  /**
+   * @class FirstTouchAllocator Numa.hpp
+   *
+   * Allocateur dont la construction par défaut n'initialise pas les éléments
+   * trivialement constructibles : un std::vector< T, FirstTouchAllocator< T >
+   * > de n éléments n'accède alors à aucune de ses pages, qui seront placées
+   * par Numa::firstTouch sur le nœud du thread qui les touche en premier.
+   *
+   * @note Les grands blocs étant obtenus par mmap (glibc), leurs pages ne
+   *   sont attribuées à un nœud qu'au premier accès.
+   */
+  template< typename T >
+  class FirstTouchAllocator : public std::allocator< T > {
+  public:
+
+    template< typename U >
+    struct rebind {
+      typedef FirstTouchAllocator< U > other;
+    };
+
+    FirstTouchAllocator() = default;
+
+    template< typename U >
+    FirstTouchAllocator(const FirstTouchAllocator< U >&) noexcept {
+    }
+
+    /**
+     * Construction par défaut sans initialisation.
+     *
+     * @param[in] p - l'emplacement de l'élément.
+     */
+    template< typename U >
+    void construct(U* p) {
+      ::new(static_cast< void* >(p)) U;
+    }
+
+    /**
+     * Construction à partir d'arguments.
+     *
+     * @param[in] p - l'emplacement de l'élément ;
+     * @param[in] args - les arguments du constructeur.
+     */
+    template< typename U, typename... Args >
+    void construct(U* p, Args&&... args) {
+      ::new(static_cast< void* >(p)) U(std::forward< Args >(args)...);
+    }
+
+  }; // FirstTouchAllocator
+
+} // merging
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef OmpTeam_hpp
+#define OmpTeam_hpp
+
+#include <functional>
+#include <algorithm>
+#include <exception>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * @class OmpTeam OmpTeam.hpp
+   *
+   * Équipe OpenMP persistante : un thread dédié ouvre une fois pour toutes
+   * une région parallèle dont le thread maître, seul dans un bloc single,
+   * exécute les travaux soumis par run. Les tâches créées par un travail
+   * sont exécutées par les autres threads de l'équipe, qui attendent à la
+   * barrière de fin du bloc single. Chaque appel de run évite ainsi
+   * l'ouverture et la fermeture d'une région parallèle.
+   *
+   * @note Les travaux sont exécutés un à la fois : les appels concurrents de
+   *   run (par exemple depuis plusieurs threads TBB) sont sérialisés au lieu
+   *   d'ouvrir chacun leur propre équipe et de surcharger la machine.
+   * @note Un travail s'exécute dans une région parallèle : omp_in_parallel y
+   *   est vrai et il ne doit pas lui-même appeler run.
+   */
+  class OmpTeam {
+  public:
+
+    /**
+     * Constructeur : démarre l'équipe.
+     *
+     * @param[in] threads - le nombre de threads de l'équipe.
+     */
+    explicit OmpTeam(const int& threads)
+      : threads(std::max(threads, 1)), job(nullptr), submitted(0),
+	completed(0), stop(false) {
+      master = std::thread([this]() { loop(); });
+    }
+
+    /**
+     * Destructeur : arrête l'équipe.
+     */
+    ~OmpTeam() {
+      {
+	std::lock_guard< std::mutex > lock(mutex);
+	stop = true;
+      }
+      ready.notify_all();
+      master.join();
+    }
+
+    OmpTeam(const OmpTeam&) = delete;
+    OmpTeam& operator=(const OmpTeam&) = delete;
+
+    /**
+     * Exécute un travail sur le thread maître de l'équipe et attend la fin
+     * de toutes les tâches qu'il a créées.
+     *
+     * @param[in] f - le travail.
+     * @throw l'exception éventuellement levée par le travail.
+     */
+    void run(const std::function< void() >& f) {
+      std::lock_guard< std::mutex > serial(callers);
+      std::unique_lock< std::mutex > lock(mutex);
+      job = &f;
+      error = nullptr;
+      const size_t ticket = ++ submitted;
+      ready.notify_all();
+      done.wait(lock, [&]() { return completed == ticket; });
+      job = nullptr;
+      if (error) {
+	std::rethrow_exception(error);
+      }
+    }
+
+    /**
+     * Retourne le nombre de threads de l'équipe.
+     *
+     * @return le nombre de threads.
+     */
+    int size() const {
+      return threads;
+    }
+
+    /**
+     * Retourne l'équipe partagée du processus, de omp_get_max_threads()
+     * threads, démarrée au premier appel.
+     *
+     * @return l'équipe partagée.
+     */
+    static OmpTeam& shared() {
+      static OmpTeam team(omp_get_max_threads());
+      return team;
+    }
+
+  private:
+
+    /**
+     * Corps du thread dédié : la région parallèle persistante.
+     */
+    void loop() {
+      #pragma omp parallel num_threads(threads)
+      #pragma omp single
+      {
+	for (size_t served = 0; ; ) {
+	  const std::function< void() >* f;
+	  {
+	    std::unique_lock< std::mutex > lock(mutex);
+	    ready.wait(lock, [&]() { return stop || submitted != served; });
+	    if (stop) {
+	      break;
+	    }
+	    f = job;
+	    served = submitted;
+	  }
+	  std::exception_ptr failure;
+	  #pragma omp taskgroup
+	  {
+	    try {
+	      (*f)();
+	    }
+	    catch (...) {
+	      failure = std::current_exception();
+	    }
+	  }
+	  {
+	    std::lock_guard< std::mutex > lock(mutex);
+	    error = failure;
+	    completed = served;
+	  }
+	  done.notify_all();
+	}
+      }
+    }
+
+    const int threads;                       /** Taille de l'équipe. */
+    const std::function< void() >* job;      /** Le travail courant. */
+    size_t submitted;                        /** Travaux soumis. */
+    size_t completed;                        /** Travaux terminés. */
+    bool stop;                               /** Demande d'arrêt. */
+    std::exception_ptr error;                /** Exception du travail. */
+    std::mutex mutex;                        /** Verrou de l'état. */
+    std::mutex callers;                      /** Sérialise les appels. */
+    std::condition_variable ready;           /** Travail disponible. */
+    std::condition_variable done;            /** Travail terminé. */
+    std::thread master;                      /** Thread dédié. */
+
+  }; // OmpTeam
+
+} // merging
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef ParallelMultiwayMerge_hpp
+#define ParallelMultiwayMerge_hpp
+
+#include "LoserTree.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cmath>
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * @class ParallelMultiwayMerge ParallelMultiwayMerge.hpp
+   *
+   * Version OpenMP d'une fusion de k sous-conteneurs triés en une seule passe
+   * sur la mémoire.
+   *
+   * @note Le conteneur cible est découpé en fragments de tailles égales, un
+   *   par thread. Les bornes de chaque fragment dans les k sous-conteneurs
+   *   sont obtenues par une généralisation de ParallelStableMerge::coRank à k
+   *   sous-conteneurs (multisequence selection) : une recherche par médiane
+   *   pondérée des médianes élimine au moins le quart des candidats restants
+   *   à chaque tour. Chaque fragment est ensuite fusionné séquentiellement
+   *   via un arbre des perdants.
+   * @note La fusion est stable : à égalité, les éléments du sous-conteneur de
+   *   plus petit indice sont placés en premier. La relation d'ordre doit être
+   *   stricte (< ou >).
+   */
+  class ParallelMultiwayMerge {
+  public:
+
+    /**
+     * Implémentation parallèle.
+     *
+     * @param[in] sequences - les couples d'itérateurs [premier, dernier)
+     *   délimitant chacun des sous-conteneurs à fusionner ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    apply(const std::vector< std::pair< InputRandomAccessIterator,
+					InputRandomAccessIterator > >& sequences,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  const int& threads) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Nombre de sous-conteneurs et taille du conteneur cible.
+      const size_t k = sequences.size();
+      OutputSize total = 0;
+      for (const auto& sequence : sequences) {
+	total += sequence.second - sequence.first;
+      }
+
+      // Calcul de la taille des fragments dans le conteneur cible de la fusion.
+      const OutputSize taille = std::ceil(total * 1.0 / threads);
+
+      // Boucle for parallèle sur les fragments.
+      #pragma omp parallel for num_threads(threads) schedule(static)
+      for (int r = 0; r < threads; r ++) {
+
+	// Calcul des rangs i_{r} et i_{r+1} délimitant le fragment courant.
+	const OutputSize ir = std::min< OutputSize >(r * taille, total);
+	const OutputSize irp1 = std::min< OutputSize >(ir + taille, total);
+	if (ir == irp1) {
+	  continue;
+	}
+
+	// Bornes du fragment dans chacun des sous-conteneurs.
+	std::vector< InputRandomAccessIterator > first(k), last(k);
+	{
+	  std::vector< OutputSize > lower, upper;
+	  multiCoRank(ir, sequences, comp, lower);
+	  multiCoRank(irp1, sequences, comp, upper);
+	  for (size_t s = 0; s != k; s ++) {
+	    first[s] = sequences[s].first + lower[s];
+	    last[s] = sequences[s].first + upper[s];
+	  }
+	}
+
+	// Fusion séquentielle du fragment via un arbre des perdants.
+	LoserTree< InputRandomAccessIterator, Compare > tree(k, comp);
+	tree.merge(first, last, result + ir);
+      }
+
+      // Respect de la sémantique de l'algorithme merge.
+      return result + total;
+
+    } // apply
+
+    /**
+     * Implémentation parallèle pour la relation d'ordre total strictement
+     * inférieur à.
+     *
+     * @param[in] sequences - les couples d'itérateurs [premier, dernier)
+     *   délimitant chacun des sous-conteneurs à fusionner ;
+     * @param[in] result - un itérateur repérant la position ou récopier le
+     *   premier élément résultant de la fusion ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin de la zone de fusion dans le
+     *   conteneur cible.
+     */
+    template< typename InputRandomAccessIterator,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    apply(const std::vector< std::pair< InputRandomAccessIterator,
+					InputRandomAccessIterator > >& sequences,
+	  const OutputRandomAccessIterator& result,
+	  const int& threads) {
+
+      // Type synonyme pour le type des éléments des sous-conteneurs.
+      typedef std::iterator_traits< InputRandomAccessIterator > Traits;
+      typedef typename Traits::value_type value_type;
+
+      // Fabriquer le comparateur less puis invoquer la méthode définie
+      // ci-dessus.
+      return apply(sequences,
+		   result,
+		   std::less< const value_type& >(),
+		   threads);
+
+    } // apply
+
+  protected:
+
+    /**
+     * Recherche des rangs (j_0, ..., j_{k-1}), respectivement dans chacun des
+     * sous-conteneurs, des éléments susceptibles d'être accueillis à la
+     * position de rang i dans le conteneur cible de la fusion.
+     *
+     * Les éléments sont totalement ordonnés par (valeur, indice du
+     * sous-conteneur, position). Pour chaque sous-conteneur s, l'intervalle
+     * [low_s, high_s] contient j_s. À chaque tour, l'élément médian de chaque
+     * intervalle est candidat et la médiane de ces candidats, pondérée par la
+     * taille des intervalles, sert de pivot : son rang global permet de
+     * resserrer tous les intervalles à la fois.
+     *
+     * @param[in] i - le rang de l'élément actuellement traité dans le conteneur
+     *   cible de la fusion ;
+     * @param[in] sequences - les sous-conteneurs à fusionner ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les éléments des conteneurs à fusionner ;
+     * @param[out] j - le rang du candidat potentiel dans chaque
+     *   sous-conteneur.
+     */
+    template< typename OutputSize,
+	      typename InputRandomAccessIterator,
+	      typename Compare >
+    static void
+    multiCoRank(const OutputSize& i,
+		const std::vector< std::pair< InputRandomAccessIterator,
+					      InputRandomAccessIterator > >& sequences,
+		const Compare& comp,
+		std::vector< OutputSize >& j) {
+
+      const size_t k = sequences.size();
+      std::vector< OutputSize > low(k, 0), high(k);
+      for (size_t s = 0; s != k; s ++) {
+	high[s] = sequences[s].second - sequences[s].first;
+      }
+
+      // Un candidat : (indice du sous-conteneur, position, poids).
+      struct Candidate {
+	size_t s;
+	OutputSize p;
+	OutputSize weight;
+      };
+      std::vector< Candidate > candidates;
+      candidates.reserve(k);
+
+      // Ordre total (valeur, indice du sous-conteneur, position).
+      const auto before = [&](const Candidate& a, const Candidate& b) {
+	const auto& x = *(sequences[a.s].first + a.p);
+	const auto& y = *(sequences[b.s].first + b.p);
+	if (comp(x, y)) {
+	  return true;
+	}
+	if (comp(y, x)) {
+	  return false;
+	}
+	return a.s < b.s || (a.s == b.s && a.p < b.p);
+      };
+
+      while (true) {
+
+	// Les intervalles sont réduits à leur borne inférieure ou supérieure.
+	OutputSize sumLow = 0, sumHigh = 0, weight = 0;
+	candidates.clear();
+	for (size_t s = 0; s != k; s ++) {
+	  sumLow += low[s];
+	  sumHigh += high[s];
+	  if (low[s] < high[s]) {
+	    const OutputSize w = high[s] - low[s];
+	    candidates.push_back({ s, low[s] + w / 2, w });
+	    weight += w;
+	  }
+	}
+	if (sumLow == i) {
+	  j = low;
+	  return;
+	}
+	if (sumHigh == i) {
+	  j = high;
+	  return;
+	}
+
+	// Médiane pondérée des candidats.
+	std::sort(candidates.begin(), candidates.end(), before);
+	OutputSize accumulated = 0;
+	size_t m = 0;
+	while (2 * (accumulated + candidates[m].weight) < weight) {
+	  accumulated += candidates[m].weight;
+	  m ++;
+	}
+	const Candidate pivot = candidates[m];
+	const auto& value = *(sequences[pivot.s].first + pivot.p);
+
+	// Nombre d'éléments de chaque sous-conteneur précédant le pivot dans
+	// l'ordre total, puis rang global du pivot.
+	std::vector< OutputSize > count(k);
+	OutputSize rank = 0;
+	for (size_t s = 0; s != k; s ++) {
+	  if (s < pivot.s) {
+	    count[s] = std::upper_bound(sequences[s].first,
+					sequences[s].second,
+					value,
+					comp) - sequences[s].first;
+	  }
+	  else if (s > pivot.s) {
+	    count[s] = std::lower_bound(sequences[s].first,
+					sequences[s].second,
+					value,
+					comp) - sequences[s].first;
+	  }
+	  else {
+	    count[s] = pivot.p;
+	  }
+	  rank += count[s];
+	}
+
+	// Le pivot occupe exactement le rang i.
+	if (rank == i) {
+	  j = count;
+	  return;
+	}
+
+	// Le pivot et tout ce qui le précède appartiennent aux i premiers
+	// éléments : resserrement par le bas.
+	if (rank < i) {
+	  for (size_t s = 0; s != k; s ++) {
+	    low[s] = std::max(low[s], count[s]);
+	  }
+	  low[pivot.s] = std::max(low[pivot.s], pivot.p + 1);
+	}
+	// Le pivot et tout ce qui le suit en sont exclus : resserrement par le
+	// haut.
+	else {
+	  for (size_t s = 0; s != k; s ++) {
+	    high[s] = std::min(high[s], count[s]);
+	  }
+	}
+      }
+
+    } // multiCoRank
+
+  }; // ParallelMultiwayMerge
+
+} // merging
+
+#endif
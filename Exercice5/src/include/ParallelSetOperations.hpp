@@ -0,0 +1,537 @@
+#ifndef ParallelSetOperations_hpp
+#define ParallelSetOperations_hpp
+
+#include "Exercice5Test.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <cmath>
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * @class ParallelSetOperations ParallelSetOperations.hpp
+   *
+   * Versions OpenMP des opérations ensemblistes de la bibliothèque standard
+   * sur des sous-conteneurs triés : set_union, set_intersection,
+   * set_difference, ainsi qu'une union sans doublons (uniqueUnion).
+   *
+   * @note Les deux sous-conteneurs sont découpés en threads tranches :
+   *   ParallelStableMerge::coRank fournit, pour le rang r * ceil((m + n) /
+   *   threads) de leur fusion, un couple (j, k) équilibré, puis la frontière
+   *   est ramenée à la première occurrence de la valeur v suivant ce couple
+   *   (lower_bound de v dans chaque sous-conteneur) : toutes les occurrences
+   *   d'une même valeur tombent ainsi dans la même tranche, et chaque
+   *   tranche peut être traitée indépendamment des autres.
+   * @note La taille du résultat n'étant pas connue à l'avance, le traitement
+   *   se fait en deux passes dans une même région parallèle : chaque tranche
+   *   compte d'abord les éléments qu'elle produira, la somme préfixe de ces
+   *   comptes donne la position de chaque tranche dans le conteneur cible,
+   *   puis chaque tranche y écrit son résultat.
+   * @note Contrairement à ParallelStableMerge, la relation d'ordre est
+   *   stricte (< ou >), comme pour les algorithmes de la bibliothèque
+   *   standard.
+   */
+  class ParallelSetOperations : protected ParallelStableMerge {
+  public:
+
+    /**
+     * Union parallèle (sémantique de std::set_union : une valeur présente c1
+     * et c2 fois apparaît max(c1, c2) fois).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    setUnion(const InputRandomAccessIterator1& first1,
+	     const InputRandomAccessIterator1& last1,
+	     const InputRandomAccessIterator2& first2,
+	     const InputRandomAccessIterator2& last2,
+	     const OutputRandomAccessIterator& result,
+	     const Compare& comp,
+	     const int& threads) {
+      return apply(Union(), first1, last1, first2, last2, result, comp,
+		   threads);
+    } // setUnion
+
+    /**
+     * Union parallèle pour la relation d'ordre total strictement inférieur à.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    setUnion(const InputRandomAccessIterator1& first1,
+	 const InputRandomAccessIterator1& last1,
+	 const InputRandomAccessIterator2& first2,
+	 const InputRandomAccessIterator2& last2,
+	 const OutputRandomAccessIterator& result,
+	 const int& threads) {
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+      return setUnion(first1, last1, first2, last2, result,
+		      std::less< const value_type& >(), threads);
+    } // setUnion
+
+    /**
+     * Intersection parallèle (sémantique de std::set_intersection : une
+     * valeur présente c1 et c2 fois apparaît min(c1, c2) fois).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    setIntersection(const InputRandomAccessIterator1& first1,
+		    const InputRandomAccessIterator1& last1,
+		    const InputRandomAccessIterator2& first2,
+		    const InputRandomAccessIterator2& last2,
+		    const OutputRandomAccessIterator& result,
+		    const Compare& comp,
+		    const int& threads) {
+      return apply(Intersection(), first1, last1, first2, last2, result, comp,
+		   threads);
+    } // setIntersection
+
+    /**
+     * Intersection parallèle pour la relation d'ordre total strictement
+     * inférieur à.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    setIntersection(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& result,
+		const int& threads) {
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+      return setIntersection(first1, last1, first2, last2, result,
+			     std::less< const value_type& >(), threads);
+    } // setIntersection
+
+    /**
+     * Différence parallèle (sémantique de std::set_difference : une valeur
+     * présente c1 et c2 fois apparaît max(c1 - c2, 0) fois).
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    setDifference(const InputRandomAccessIterator1& first1,
+		  const InputRandomAccessIterator1& last1,
+		  const InputRandomAccessIterator2& first2,
+		  const InputRandomAccessIterator2& last2,
+		  const OutputRandomAccessIterator& result,
+		  const Compare& comp,
+		  const int& threads) {
+      return apply(Difference(), first1, last1, first2, last2, result, comp,
+		   threads);
+    } // setDifference
+
+    /**
+     * Différence parallèle pour la relation d'ordre total strictement
+     * inférieur à.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    setDifference(const InputRandomAccessIterator1& first1,
+	      const InputRandomAccessIterator1& last1,
+	      const InputRandomAccessIterator2& first2,
+	      const InputRandomAccessIterator2& last2,
+	      const OutputRandomAccessIterator& result,
+	      const int& threads) {
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+      return setDifference(first1, last1, first2, last2, result,
+			   std::less< const value_type& >(), threads);
+    } // setDifference
+
+    /**
+     * Union parallèle sans doublons : chaque valeur présente dans l'un des
+     * sous-conteneurs apparaît exactement une fois dans le résultat, même si
+     * elle est répétée dans les sous-conteneurs.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    uniqueUnion(const InputRandomAccessIterator1& first1,
+		const InputRandomAccessIterator1& last1,
+		const InputRandomAccessIterator2& first2,
+		const InputRandomAccessIterator2& last2,
+		const OutputRandomAccessIterator& result,
+		const Compare& comp,
+		const int& threads) {
+      return apply(UniqueUnion(), first1, last1, first2, last2, result, comp,
+		   threads);
+    } // uniqueUnion
+
+    /**
+     * Union parallèle sans doublons pour la relation d'ordre total strictement
+     * inférieur à.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static OutputRandomAccessIterator
+    uniqueUnion(const InputRandomAccessIterator1& first1,
+	    const InputRandomAccessIterator1& last1,
+	    const InputRandomAccessIterator2& first2,
+	    const InputRandomAccessIterator2& last2,
+	    const OutputRandomAccessIterator& result,
+	    const int& threads) {
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+      return uniqueUnion(first1, last1, first2, last2, result,
+			 std::less< const value_type& >(), threads);
+    } // uniqueUnion
+
+    /**
+     * Union sans doublons séquentielle, employée sur chaque tranche.
+     *
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les sous-conteneurs.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename InputIterator1,
+	      typename InputIterator2,
+	      typename OutputIterator,
+	      typename Compare >
+    static OutputIterator
+    sequentialUniqueUnion(InputIterator1 first1,
+			  const InputIterator1& last1,
+			  InputIterator2 first2,
+			  const InputIterator2& last2,
+			  OutputIterator result,
+			  const Compare& comp) {
+      while (first1 != last1 || first2 != last2) {
+
+	// Plus petite valeur restante, prise dans le premier sous-conteneur à
+	// égalité.
+	const bool one = first2 == last2 ||
+	  (first1 != last1 && ! comp(*first2, *first1));
+	const auto value = one ? *first1 : *first2;
+	*result = value;
+	++ result;
+
+	// Toutes ses occurrences sont sautées dans les deux sous-conteneurs.
+	while (first1 != last1 && ! comp(value, *first1)) {
+	  ++ first1;
+	}
+	while (first2 != last2 && ! comp(value, *first2)) {
+	  ++ first2;
+	}
+      }
+      return result;
+    } // sequentialUniqueUnion
+
+  protected:
+
+    /**
+     * Itérateur de sortie comptant les éléments écrits, employé par la
+     * première passe.
+     */
+    struct CountingIterator {
+      typedef std::output_iterator_tag iterator_category;
+      typedef void value_type;
+      typedef void difference_type;
+      typedef void pointer;
+      typedef void reference;
+
+      size_t count = 0;   /** Le nombre d'éléments écrits. */
+
+      CountingIterator& operator*() {
+	return *this;
+      }
+
+      template< typename T >
+      CountingIterator& operator=(const T&) {
+	return *this;
+      }
+
+      CountingIterator& operator++() {
+	++ count;
+	return *this;
+      }
+
+      CountingIterator operator++(int) {
+	CountingIterator previous = *this;
+	++ count;
+	return previous;
+      }
+    };
+
+    /**
+     * Opérations séquentielles appliquées à chaque tranche.
+     */
+    struct Union {
+      template< typename I1, typename I2, typename O, typename C >
+      O operator()(I1 f1, I1 l1, I2 f2, I2 l2, O o, const C& c) const {
+	return std::set_union(f1, l1, f2, l2, o, c);
+      }
+    };
+
+    struct Intersection {
+      template< typename I1, typename I2, typename O, typename C >
+      O operator()(I1 f1, I1 l1, I2 f2, I2 l2, O o, const C& c) const {
+	return std::set_intersection(f1, l1, f2, l2, o, c);
+      }
+    };
+
+    struct Difference {
+      template< typename I1, typename I2, typename O, typename C >
+      O operator()(I1 f1, I1 l1, I2 f2, I2 l2, O o, const C& c) const {
+	return std::set_difference(f1, l1, f2, l2, o, c);
+      }
+    };
+
+    struct UniqueUnion {
+      template< typename I1, typename I2, typename O, typename C >
+      O operator()(I1 f1, I1 l1, I2 f2, I2 l2, O o, const C& c) const {
+	return sequentialUniqueUnion(f1, l1, f2, l2, o, c);
+      }
+    };
+
+    /**
+     * Découpage en tranches, comptage puis écriture.
+     *
+     * @param[in] operation - l'opération séquentielle appliquée à chaque
+     *   tranche ;
+     * @param[in] first1 - un itérateur repérant le premier élément du premier
+     *   sous-conteneur ;
+     * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du premier sous-conteneur ;
+     * @param[in] first2 - un itérateur repérant le premier élément du second
+     *   sous-conteneur ;
+     * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+     *   le dernier élément du second sous-conteneur ;
+     * @param[in] result - un itérateur repérant la position où recopier le
+     *   premier élément du résultat ;
+     * @param[in] comp - un comparateur binaire représentant la relation
+     *   d'ordre total strict régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     * @return un itérateur repérant la fin du résultat.
+     */
+    template< typename Operation,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static OutputRandomAccessIterator
+    apply(const Operation& operation,
+	  const InputRandomAccessIterator1& first1,
+	  const InputRandomAccessIterator1& last1,
+	  const InputRandomAccessIterator2& first2,
+	  const InputRandomAccessIterator2& last2,
+	  const OutputRandomAccessIterator& result,
+	  const Compare& comp,
+	  const int& threads) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsInput1::difference_type OutputSize;
+
+      const InputSize1 m = last1 - first1;
+      const InputSize2 n = last2 - first2;
+      const OutputSize mpn = m + n;
+      const OutputSize taille = std::ceil(mpn * 1.0 / threads);
+
+      // Relation d'ordre de type <= attendue par coRank.
+      const auto lessEqual = [&](const auto& x, const auto& y) {
+	return ! comp(y, x);
+      };
+
+      std::vector< InputSize1 > j(threads + 1);
+      std::vector< InputSize2 > k(threads + 1);
+      std::vector< size_t > offsets(threads + 1, 0);
+
+      #pragma omp parallel num_threads(threads)
+      {
+	// Frontières des tranches : co-rangs équilibrés, ramenés à la
+	// première occurrence de la valeur qui les suit.
+	#pragma omp for schedule(static)
+	for (int r = 0; r <= threads; r ++) {
+	  const OutputSize i = std::min< OutputSize >(r * taille, mpn);
+	  InputSize1 jr;
+	  InputSize2 kr;
+	  coRank(i, first1, m, first2, n, lessEqual, jr, kr);
+	  if (jr < m || kr < n) {
+	    const auto& v = jr == m ? first2[kr] :
+	      (kr == n || ! comp(first2[kr], first1[jr]) ? first1[jr] :
+	       first2[kr]);
+	    jr = std::lower_bound(first1, first1 + jr, v, comp) - first1;
+	    kr = std::lower_bound(first2, first2 + kr, v, comp) - first2;
+	  }
+	  j[r] = jr;
+	  k[r] = kr;
+	}
+
+	// Première passe : taille du résultat de chaque tranche.
+	#pragma omp for schedule(static)
+	for (int r = 0; r < threads; r ++) {
+	  offsets[r + 1] = operation(first1 + j[r], first1 + j[r + 1],
+				     first2 + k[r], first2 + k[r + 1],
+				     CountingIterator(), comp).count;
+	}
+
+	// Somme préfixe : position de chaque tranche dans le résultat.
+	#pragma omp single
+	for (int r = 0; r < threads; r ++) {
+	  offsets[r + 1] += offsets[r];
+	}
+
+	// Seconde passe : écriture de chaque tranche à sa position.
+	#pragma omp for schedule(static)
+	for (int r = 0; r < threads; r ++) {
+	  operation(first1 + j[r], first1 + j[r + 1],
+		    first2 + k[r], first2 + k[r + 1],
+		    result + offsets[r], comp);
+	}
+      }
+
+      return result + offsets[threads];
+
+    } // apply
+
+  }; // ParallelSetOperations
+
+} // merging
+
+#endif
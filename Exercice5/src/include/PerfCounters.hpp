@@ -0,0 +1,286 @@
+#ifndef PerfCounters_hpp
+#define PerfCounters_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+#if defined(__linux__)
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/**
+ * @class PerfCounters PerfCounters.hpp
+ *
+ * Compteurs matériels (cycles, instructions, défauts du dernier niveau de
+ * cache, mauvaises prédictions de branchement et défauts de TLB de données)
+ * relevés par perf_event_open sur chacun des threads du processus, entre
+ * deux appels start() et stop().
+ *
+ * @note Les compteurs ne suivent que les threads existant lors de la
+ *   construction : les réserves de threads de TBB et d'OpenMP doivent donc
+ *   avoir été créées au préalable (par une exécution de chauffe, par
+ *   exemple).
+ * @note Seul l'espace utilisateur est compté, ce qu'autorise le réglage par
+ *   défaut de /proc/sys/kernel/perf_event_paranoid (2). Un compteur refusé
+ *   (droits, conteneur, machine virtuelle, événement inconnu du processeur)
+ *   est simplement marqué indisponible ; hors Linux, aucun ne l'est.
+ * @note Lorsque le noyau multiplexe les compteurs, les valeurs sont
+ *   extrapolées au prorata du temps de comptage effectif.
+ */
+class PerfCounters {
+public:
+
+  /**
+   * Les événements comptés.
+   */
+  enum Event {
+    CYCLES,          /** Les cycles. */
+    INSTRUCTIONS,    /** Les instructions retirées. */
+    LLC_MISSES,      /** Les défauts du dernier niveau de cache. */
+    BRANCH_MISSES,   /** Les mauvaises prédictions de branchement. */
+    DTLB_MISSES,     /** Les défauts de TLB de données (lectures). */
+    EVENTS           /** Le nombre d'événements. */
+  };
+
+  /**
+   * Les valeurs relevées pour un thread (ou leur somme).
+   */
+  struct Sample {
+    long tid;                      /** Le thread (0 pour une somme). */
+    std::uint64_t values[EVENTS];  /** Les valeurs de chaque événement. */
+    bool valid[EVENTS];            /** Vrai si l'événement a été compté. */
+
+    /**
+     * Retourne le nombre d'instructions par cycle.
+     *
+     * @return l'IPC ou 0 si l'un des deux compteurs manque.
+     */
+    double ipc() const {
+      return valid[CYCLES] && valid[INSTRUCTIONS] && values[CYCLES] != 0 ?
+	static_cast< double >(values[INSTRUCTIONS]) / values[CYCLES] : 0;
+    }
+  };
+
+  /**
+   * Constructeur : ouvre, désactivés, les compteurs de chaque thread du
+   * processus.
+   */
+  PerfCounters() {
+#if defined(__linux__)
+    DIR* directory = opendir("/proc/self/task");
+    if (directory == nullptr) {
+      return;
+    }
+    while (const dirent* entry = readdir(directory)) {
+      const long tid = std::strtol(entry->d_name, nullptr, 10);
+      if (tid <= 0) {
+	continue;
+      }
+      Thread thread;
+      thread.tid = tid;
+      for (int e = 0; e != EVENTS; e ++) {
+	thread.fds[e] = open(static_cast< Event >(e), tid);
+      }
+      threads.push_back(thread);
+    }
+    closedir(directory);
+#endif
+  }
+
+  /**
+   * Destructeur : ferme les compteurs.
+   */
+  ~PerfCounters() {
+    for (const Thread& thread : threads) {
+      for (const int fd : thread.fds) {
+	if (fd != -1) {
+	  close(fd);
+	}
+      }
+    }
+  }
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  /**
+   * Indique si au moins un compteur a pu être ouvert.
+   *
+   * @return vrai si des valeurs seront relevées.
+   */
+  bool available() const {
+    for (const Thread& thread : threads) {
+      for (const int fd : thread.fds) {
+	if (fd != -1) {
+	  return true;
+	}
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Remet à zéro puis active tous les compteurs.
+   */
+  void start() {
+#if defined(__linux__)
+    for (const Thread& thread : threads) {
+      for (const int fd : thread.fds) {
+	if (fd != -1) {
+	  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+	  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+      }
+    }
+#endif
+  }
+
+  /**
+   * Désactive tous les compteurs et relève leurs valeurs.
+   *
+   * @return les valeurs de chaque thread ayant compté au moins un cycle ou
+   *   une instruction, les threads restés endormis étant omis.
+   */
+  std::vector< Sample > stop() {
+    std::vector< Sample > samples;
+#if defined(__linux__)
+    for (const Thread& thread : threads) {
+      for (const int fd : thread.fds) {
+	if (fd != -1) {
+	  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+	}
+      }
+    }
+    for (const Thread& thread : threads) {
+      Sample sample = { thread.tid, { 0 }, { false } };
+      for (int e = 0; e != EVENTS; e ++) {
+	sample.valid[e] = read(thread.fds[e], sample.values[e]);
+      }
+      if (sample.values[CYCLES] != 0 || sample.values[INSTRUCTIONS] != 0) {
+	samples.push_back(sample);
+      }
+    }
+#endif
+    return samples;
+  }
+
+  /**
+   * Additionne les valeurs de plusieurs threads.
+   *
+   * @param[in] samples - les valeurs de chaque thread.
+   * @return leur somme, un événement n'étant valide que s'il l'est pour au
+   *   moins un thread.
+   */
+  static Sample total(const std::vector< Sample >& samples) {
+    Sample sum = { 0, { 0 }, { false } };
+    for (const Sample& sample : samples) {
+      for (int e = 0; e != EVENTS; e ++) {
+	sum.values[e] += sample.values[e];
+	sum.valid[e] = sum.valid[e] || sample.valid[e];
+      }
+    }
+    return sum;
+  }
+
+  /**
+   * Retourne le nom d'un événement.
+   *
+   * @param[in] event - l'événement.
+   * @return son nom.
+   */
+  static const char* name(const Event& event) {
+    static const char* const names[EVENTS] = {
+      "cycles", "instructions", "llc_misses", "branch_misses", "dtlb_misses"
+    };
+    return names[event];
+  }
+
+private:
+
+  /**
+   * Les compteurs d'un thread.
+   */
+  struct Thread {
+    long tid;          /** Le thread. */
+    int fds[EVENTS];   /** Ses compteurs, -1 si indisponibles. */
+  };
+
+  std::vector< Thread > threads;   /** Les compteurs de chaque thread. */
+
+#if defined(__linux__)
+  /**
+   * Ouvre, désactivé, le compteur d'un événement sur un thread.
+   *
+   * @param[in] event - l'événement ;
+   * @param[in] tid - le thread.
+   * @return le descripteur du compteur ou -1 s'il est indisponible.
+   */
+  static int open(const Event& event, const long& tid) {
+    perf_event_attr attr = perf_event_attr();
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (event) {
+    case CYCLES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case INSTRUCTIONS:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case LLC_MISSES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case BRANCH_MISSES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    default:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_DTLB |
+	(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+	(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    }
+    return static_cast< int >(syscall(SYS_perf_event_open, &attr, tid, -1, -1,
+				      0));
+  }
+
+  /**
+   * Lit un compteur, extrapolé s'il a été multiplexé.
+   *
+   * @param[in] fd - le descripteur du compteur ;
+   * @param[out] value - sa valeur.
+   * @return faux si le compteur est indisponible ou n'a jamais été
+   *   programmé sur le processeur.
+   */
+  static bool read(const int& fd, std::uint64_t& value) {
+    std::uint64_t data[3];   // Valeur, temps activé, temps de comptage.
+    value = 0;
+    if (fd == -1 || ::read(fd, data, sizeof(data)) != sizeof(data)) {
+      return false;
+    }
+    if (data[2] == 0) {
+      return data[1] == 0;
+    }
+    value = data[2] < data[1] ?
+      static_cast< std::uint64_t >(static_cast< double >(data[0]) *
+				   data[1] / data[2]) :
+      data[0];
+    return true;
+  }
+#endif
+
+}; // PerfCounters
+
+#endif
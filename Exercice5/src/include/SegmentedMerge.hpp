@@ -0,0 +1,218 @@
+#ifndef SegmentedMerge_hpp
+#define SegmentedMerge_hpp
+
+#include "Exercice5Test.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <cmath>
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * @class MergeSegment SegmentedMerge.hpp
+   *
+   * Une fusion élémentaire d'un lot : deux sous-conteneurs triés et la
+   * position de leur fusion dans un conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator >
+  struct MergeSegment {
+    InputRandomAccessIterator1 first1;   /** Début du premier. */
+    InputRandomAccessIterator1 last1;    /** Fin du premier. */
+    InputRandomAccessIterator2 first2;   /** Début du second. */
+    InputRandomAccessIterator2 last2;    /** Fin du second. */
+    OutputRandomAccessIterator result;   /** Début de la cible. */
+  };
+
+  /**
+   * @class SegmentedMerge SegmentedMerge.hpp
+   *
+   * Fusion d'un lot de paires de sous-conteneurs en une seule région
+   * parallèle : les fusions d'un lot sont le plus souvent bien trop petites
+   * pour amortir chacune l'ouverture d'une région OpenMP.
+   *
+   * @note Les cibles des fusions sont vues comme un unique conteneur virtuel
+   *   de taille W (la somme des tailles), découpé en threads fragments de
+   *   ceil(W / threads) éléments. Une frontière tombant dans un segment d'au
+   *   plus grain éléments est repoussée au bord le plus proche de ce
+   *   segment, fusionné alors en entier par un seul thread ; un segment plus
+   *   grand est partagé entre plusieurs threads, les bornes de chaque partie
+   *   étant calculées par ParallelStableMerge::coRank. Chaque thread parcourt
+   *   ensuite les segments de son fragment en invoquant le noyau Leaf.
+   * @note Comme pour ParallelStableMerge, la relation d'ordre peut être
+   *   stricte (voir ParallelStableMerge::StrictOrder) ou de type <= ou >=,
+   *   et la fusion de chaque segment est stable.
+   */
+  class SegmentedMerge : protected ParallelStableMerge {
+  public:
+
+    /**
+     * Implémentation parallèle.
+     *
+     * @param[in] segments - les fusions du lot ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles ;
+     * @param[in] grain - la taille au dessous de laquelle un segment n'est
+     *   jamais partagé entre plusieurs threads.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void
+    apply(const std::vector< MergeSegment< InputRandomAccessIterator1,
+					   InputRandomAccessIterator2,
+					   OutputRandomAccessIterator > >&
+	    segments,
+	  const Compare& comp,
+	  const int& threads,
+	  const size_t& grain) {
+
+      // Types synonymes permettant de ne rien préjuger des types entiers
+      // manipulés.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > TraitsInput1;
+      typedef std::iterator_traits< InputRandomAccessIterator2 > TraitsInput2;
+      typedef std::iterator_traits< OutputRandomAccessIterator > TraitsOutput;
+      typedef typename TraitsInput1::difference_type InputSize1;
+      typedef typename TraitsInput2::difference_type InputSize2;
+      typedef typename TraitsOutput::difference_type OutputSize;
+
+      // Rang de chaque segment dans le conteneur virtuel.
+      const size_t count = segments.size();
+      std::vector< OutputSize > offsets(count + 1, 0);
+      for (size_t s = 0; s != count; s ++) {
+	offsets[s + 1] = offsets[s] +
+	  (segments[s].last1 - segments[s].first1) +
+	  (segments[s].last2 - segments[s].first2);
+      }
+      const OutputSize total = offsets[count];
+      if (total == 0) {
+	return;
+      }
+
+      // Frontières des fragments, repoussées aux bords des petits segments.
+      const OutputSize taille = std::ceil(total * 1.0 / threads);
+      std::vector< OutputSize > bounds(threads + 1);
+      for (int r = 0; r <= threads; r ++) {
+	const OutputSize i = std::min< OutputSize >(r * taille, total);
+	const size_t s =
+	  std::upper_bound(offsets.begin(), offsets.end(), i) -
+	  offsets.begin() - 1;
+	bounds[r] = i;
+	if (s < count && offsets[s] < i &&
+	    static_cast< size_t >(offsets[s + 1] - offsets[s]) <= grain) {
+	  bounds[r] = i - offsets[s] <= offsets[s + 1] - i ?
+	    offsets[s] : offsets[s + 1];
+	}
+      }
+
+      // Boucle for parallèle sur les fragments.
+      #pragma omp parallel for num_threads(threads) schedule(static)
+      for (int r = 0; r < threads; r ++) {
+	const OutputSize lo = bounds[r];
+	const OutputSize hi = bounds[r + 1];
+	size_t s = std::upper_bound(offsets.begin(), offsets.end(), lo) -
+	  offsets.begin() - 1;
+
+	// Segments, entiers ou partiels, du fragment courant.
+	for (; s < count && offsets[s] < hi; s ++) {
+	  const auto& segment = segments[s];
+	  const InputSize1 m = segment.last1 - segment.first1;
+	  const InputSize2 n = segment.last2 - segment.first2;
+	  const OutputSize ir = std::max(lo, offsets[s]) - offsets[s];
+	  const OutputSize irp1 = std::min(hi, offsets[s + 1]) - offsets[s];
+	  if (ir == irp1) {
+	    continue;
+	  }
+	  if (ir == 0 && irp1 == m + n) {
+	    Leaf::apply(segment.first1, segment.last1,
+			segment.first2, segment.last2,
+			segment.result,
+			leafOrder(comp));
+	    continue;
+	  }
+
+	  // Segment partagé : co-rangs des bornes de la partie courante.
+	  InputSize1 jr, jrp1;
+	  InputSize2 kr, krp1;
+	  coRank(ir, segment.first1, m, segment.first2, n, comp, jr, kr);
+	  coRank(irp1, segment.first1, m, segment.first2, n, comp, jrp1, krp1);
+	  Leaf::apply(segment.first1 + jr, segment.first1 + jrp1,
+		      segment.first2 + kr, segment.first2 + krp1,
+		      segment.result + ir,
+		      leafOrder(comp));
+	}
+      }
+
+    } // apply
+
+    /**
+     * Implémentation parallèle dont la taille au dessous de laquelle un
+     * segment n'est jamais partagé est celle d'un fragment tenant dans le
+     * cache (voir ParallelStableMerge::cacheGrain).
+     *
+     * @param[in] segments - les fusions du lot ;
+     * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+     *   total régissant les sous-conteneurs ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator,
+	      typename Compare >
+    static void
+    apply(const std::vector< MergeSegment< InputRandomAccessIterator1,
+					   InputRandomAccessIterator2,
+					   OutputRandomAccessIterator > >&
+	    segments,
+	  const Compare& comp,
+	  const int& threads) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      apply< Leaf >(segments, comp, threads, cacheGrain(sizeof(value_type)));
+
+    } // apply
+
+    /**
+     * Implémentation parallèle pour la relation d'ordre total inférieur ou
+     * égal.
+     *
+     * @param[in] segments - les fusions du lot ;
+     * @param[in] threads - le nombre de threads disponibles.
+     */
+    template< typename Leaf = MergeKernel,
+	      typename InputRandomAccessIterator1,
+	      typename InputRandomAccessIterator2,
+	      typename OutputRandomAccessIterator >
+    static void
+    apply(const std::vector< MergeSegment< InputRandomAccessIterator1,
+					   InputRandomAccessIterator2,
+					   OutputRandomAccessIterator > >&
+	    segments,
+	  const int& threads) {
+
+      // Type synonyme pour le type des éléments du premier conteneur.
+      typedef std::iterator_traits< InputRandomAccessIterator1 > Traits;
+      typedef typename Traits::value_type value_type;
+
+      apply< Leaf >(segments,
+		    std::less_equal< const value_type& >(),
+		    threads);
+
+    } // apply
+
+  }; // SegmentedMerge
+
+} // merging
+
+#endif
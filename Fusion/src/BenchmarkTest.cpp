@@ -0,0 +1,394 @@
+#include "Merge.hpp"
+#include "Statistics.hpp"
+#include "PerfCounters.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <functional>
+#include <numeric>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef std::int32_t Type;
+
+/**
+ * Étendue des valeurs d'un conteneur uniforme.
+ */
+static const Type RANGE = Type(1) << 29;
+
+/**
+ * Remplit un conteneur de valeurs triées, sans tri, en cumulant des écarts
+ * aléatoires : les valeurs s'étendent de begin à begin + span environ.
+ *
+ * @param[out] data - le conteneur à remplir ;
+ * @param[in] begin - la plus petite valeur ;
+ * @param[in] span - l'étendue des valeurs ;
+ * @param[in,out] generator - le générateur pseudo-aléatoire.
+ */
+void
+fill(std::vector< Type >& data, const Type& begin, const Type& span,
+     std::mt19937_64& generator) {
+  Type value = begin;
+  if (static_cast< size_t >(span) >= data.size()) {
+    std::uniform_int_distribution< Type > gap(0, 2 * (span / data.size()));
+    for (auto& x : data) {
+      value += gap(generator);
+      x = value;
+    }
+  }
+  else {
+    std::bernoulli_distribution gap(span * 1.0 / data.size());
+    for (auto& x : data) {
+      value += gap(generator);
+      x = value;
+    }
+  }
+}
+
+/**
+ * Construit deux conteneurs triés de tailles size / 2 et size - size / 2.
+ *
+ * @param[in] distribution - uniforme (valeurs entrelacées), asymetrique (le
+ *   second conteneur est concentré au début de l'étendue du premier),
+ *   doublons (16 valeurs distinctes) ou disjointes (le second conteneur suit
+ *   le premier) ;
+ * @param[in] size - le nombre total d'éléments ;
+ * @param[out] lhs - le premier conteneur ;
+ * @param[out] rhs - le second conteneur.
+ * @return faux si la distribution est inconnue.
+ */
+bool
+generate(const std::string& distribution, const size_t& size,
+	 std::vector< Type >& lhs, std::vector< Type >& rhs) {
+  std::mt19937_64 generator(19);
+  lhs.resize(size / 2);
+  rhs.resize(size - size / 2);
+  if (distribution == "uniforme") {
+    fill(lhs, 0, RANGE, generator);
+    fill(rhs, 0, RANGE, generator);
+  }
+  else if (distribution == "asymetrique") {
+    fill(lhs, 0, RANGE, generator);
+    fill(rhs, 0, RANGE / 64, generator);
+  }
+  else if (distribution == "doublons") {
+    fill(lhs, 0, 16, generator);
+    fill(rhs, 0, 16, generator);
+  }
+  else if (distribution == "disjointes") {
+    fill(lhs, 0, RANGE, generator);
+    fill(rhs, 2 * RANGE, RANGE, generator);
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Un moteur de fusion mesuré.
+ */
+struct Engine {
+  std::string name;                                   /** Son nom. */
+  std::function< int() > threads;                     /** Ses threads. */
+  std::function< void(const std::vector< Type >&,
+		      const std::vector< Type >&,
+		      std::vector< Type >&) > run;    /** Sa fusion. */
+};
+
+/**
+ * Fabrique un moteur reposant sur merging::merge.
+ *
+ * @param[in] name - le nom du moteur ;
+ * @param[in] policy - la politique d'exécution ;
+ * @param[in] threads - la fonction donnant son nombre de threads.
+ * @return le moteur.
+ */
+template< typename Policy >
+Engine
+engine(const std::string& name, const Policy& policy,
+       const std::function< int() >& threads) {
+  return Engine { name, threads,
+      [policy](const std::vector< Type >& lhs, const std::vector< Type >& rhs,
+	       std::vector< Type >& result) {
+	merging::merge(policy, lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+		       result.begin());
+      } };
+}
+
+/**
+ * Écrit les compteurs matériels d'un relevé en JSON.
+ *
+ * @param[in] sample - le relevé ;
+ * @param[in] invocations - le nombre de fusions couvertes par le relevé.
+ */
+void
+writeCounters(const PerfCounters::Sample& sample, const size_t& invocations) {
+  for (int e = 0; e != PerfCounters::EVENTS; e ++) {
+    std::cout << (e == 0 ? "" : ", ") << '"'
+	      << PerfCounters::name(static_cast< PerfCounters::Event >(e))
+	      << "\": ";
+    if (sample.valid[e]) {
+      std::cout << static_cast< double >(sample.values[e]) / invocations;
+    }
+    else {
+      std::cout << "null";
+    }
+  }
+  std::cout << ", \"ipc\": " << sample.ipc();
+}
+
+/**
+ * Écrit une mesure en CSV ou en JSON.
+ *
+ * @param[in] json - vrai pour JSON, faux pour CSV ;
+ * @param[in] first - vrai pour la première mesure ;
+ * @param[in] engine - le nom du moteur ;
+ * @param[in] distribution - le nom de la distribution ;
+ * @param[in] size - le nombre total d'éléments ;
+ * @param[in] threads - le nombre de threads ;
+ * @param[in] stats - les durées d'exécution en nanosecondes ;
+ * @param[in] ok - le verdict ;
+ * @param[in] counters - vrai si les compteurs matériels sont demandés ;
+ * @param[in] samples - les compteurs relevés par thread sur stats.count()
+ *   fusions, vide s'ils sont indisponibles.
+ */
+void
+write(const bool& json, const bool& first,
+      const std::string& engine, const std::string& distribution,
+      const size_t& size, const int& threads,
+      const Statistics& stats, const bool& ok,
+      const bool& counters,
+      const std::vector< PerfCounters::Sample >& samples) {
+  const PerfCounters::Sample total = PerfCounters::total(samples);
+  if (json) {
+    std::cout << (first ? "[\n" : ",\n")
+	      << "  { \"moteur\": \"" << engine << "\""
+	      << ", \"distribution\": \"" << distribution << "\""
+	      << ", \"taille\": " << size
+	      << ", \"threads\": " << threads
+	      << ", \"repetitions\": " << stats.count()
+	      << ", \"mediane_ns\": " << stats.median()
+	      << ", \"p95_ns\": " << stats.quantile(0.95)
+	      << ", \"min_ns\": " << stats.min()
+	      << ", \"max_ns\": " << stats.max()
+	      << ", \"moyenne_ns\": " << stats.mean()
+	      << ", \"ecart_type_ns\": " << stats.stddev()
+	      << ", \"verdict\": " << std::boolalpha << ok;
+    if (counters) {
+
+      // Compteurs par fusion : total puis détail par thread.
+      std::cout << ", \"compteurs\": ";
+      if (samples.empty()) {
+	std::cout << "null";
+      }
+      else {
+	std::cout << "{ ";
+	writeCounters(total, stats.count());
+	std::cout << ", \"par_thread\": [";
+	for (size_t t = 0; t != samples.size(); t ++) {
+	  std::cout << (t == 0 ? " { " : ", { ") << "\"tid\": "
+		    << samples[t].tid << ", ";
+	  writeCounters(samples[t], stats.count());
+	  std::cout << " }";
+	}
+	std::cout << " ] }";
+      }
+    }
+    std::cout << " }";
+  }
+  else {
+    if (first) {
+      std::cout << "moteur,distribution,taille,threads,repetitions,"
+		<< "mediane_ns,p95_ns,min_ns,max_ns,moyenne_ns,ecart_type_ns,"
+		<< "verdict";
+      if (counters) {
+	for (int e = 0; e != PerfCounters::EVENTS; e ++) {
+	  std::cout << ','
+		    << PerfCounters::name(static_cast< PerfCounters::Event >(e));
+	}
+	std::cout << ",ipc";
+      }
+      std::cout << std::endl;
+    }
+    std::cout << engine << ',' << distribution << ',' << size << ','
+	      << threads << ',' << stats.count() << ','
+	      << stats.median() << ',' << stats.quantile(0.95) << ','
+	      << stats.min() << ',' << stats.max() << ','
+	      << stats.mean() << ',' << stats.stddev() << ','
+	      << std::boolalpha << ok;
+    if (counters) {
+
+      // Compteurs par fusion, tous threads confondus ; vides s'ils sont
+      // indisponibles.
+      for (int e = 0; e != PerfCounters::EVENTS; e ++) {
+	std::cout << ',';
+	if (total.valid[e]) {
+	  std::cout << static_cast< double >(total.values[e]) / stats.count();
+	}
+      }
+      std::cout << ',';
+      if (! samples.empty()) {
+	std::cout << total.ipc();
+      }
+    }
+    std::cout << std::endl;
+  }
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0]
+	      << " json|csv taille_min taille_max nb_chauffe nb_repetitions"
+	      << " [compteurs]" << std::endl;
+    std::cout << "\tLes tailles (nombre total d'éléments fusionnés) vont de"
+	      << " taille_min à taille_max par facteur 4, par exemple de 1024"
+	      << " à 1073741824." << std::endl;
+    std::cout << "\tAvec compteurs, les compteurs matériels (cycles,"
+	      << " instructions, défauts LLC, de prédiction et de dTLB) sont"
+	      << " relevés par fusion et par thread lors d'une passe"
+	      << " supplémentaire." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 5 ou 6 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc != 6 && argc != 7) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du format, des tailles extrêmes, du nombre de
+  // fusions de chauffe et du nombre de fusions mesurées.
+  const std::string format = argv[1];
+  if (format != "json" && format != "csv") {
+    std::cerr << "Argument incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+  size_t values[4];
+  for (int a = 0; a != 4; a ++) {
+    std::istringstream entree(argv[a + 2]);
+    entree >> values[a];
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  const size_t minSize = std::max< size_t >(values[0], 2);
+  const size_t maxSize = values[1];
+  const size_t warmup = values[2];
+  const size_t repetitions = values[3];
+  const bool counters = argc == 7;
+  if (repetitions == 0 ||
+      (counters && std::string(argv[6]) != "compteurs")) {
+    std::cerr << "Argument incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (counters && ! PerfCounters().available()) {
+    std::cerr << "Compteurs matériels indisponibles (perf_event_open refusé)."
+	      << std::endl;
+  }
+
+  // Les moteurs mesurés.
+  const auto tbbThreads = []() {
+    return tbb::this_task_arena::max_concurrency();
+  };
+  const auto ompThreads = []() {
+    return omp_get_max_threads();
+  };
+  const std::vector< Engine > engines = {
+    Engine { "std::merge", []() { return 1; },
+	     [](const std::vector< Type >& lhs, const std::vector< Type >& rhs,
+		std::vector< Type >& result) {
+	       std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+			  result.begin());
+	     } },
+    engine("seq", merging::policy::seq, []() { return 1; }),
+    engine("tbb_invoke", merging::policy::tbb_invoke, tbbThreads),
+    engine("tbb_tasks", merging::policy::tbb_tasks, tbbThreads),
+    engine("omp_corank", merging::policy::omp_corank, ompThreads),
+    engine("automatic", merging::policy::automatic, tbbThreads)
+  };
+
+  const bool json = format == "json";
+  bool first = true;
+  for (const std::string distribution :
+	 { "uniforme", "asymetrique", "doublons", "disjointes" }) {
+    for (size_t size = minSize; size <= maxSize; size *= 4) {
+
+      // Les entrées et la somme de contrôle du résultat attendu.
+      std::vector< Type > lhs, rhs;
+      generate(distribution, size, lhs, rhs);
+      const std::int64_t checksum =
+	std::accumulate(lhs.begin(), lhs.end(), std::int64_t(0)) +
+	std::accumulate(rhs.begin(), rhs.end(), std::int64_t(0));
+      std::vector< Type > result(size);
+
+      for (const Engine& e : engines) {
+
+	// Fusions de chauffe non chronométrées.
+	for (size_t i = 0; i != warmup; i ++) {
+	  e.run(lhs, rhs, result);
+	}
+
+	// Fusions chronométrées une à une, à la nanoseconde.
+	std::vector< double > samples(repetitions);
+	for (size_t i = 0; i != repetitions; i ++) {
+	  const auto start = std::chrono::steady_clock::now();
+	  e.run(lhs, rhs, result);
+	  const auto stop = std::chrono::steady_clock::now();
+	  samples[i] =
+	    std::chrono::duration< double, std::nano >(stop - start).count();
+	}
+
+	// Le résultat doit être trié et contenir les mêmes éléments.
+	const bool ok = std::is_sorted(result.begin(), result.end()) &&
+	  std::accumulate(result.begin(), result.end(), std::int64_t(0)) ==
+	  checksum;
+
+	// Passe supplémentaire, non chronométrée, sous compteurs matériels :
+	// les réserves de threads existent désormais et les appels systèmes
+	// d'activation restent hors des durées mesurées.
+	std::vector< PerfCounters::Sample > perf;
+	if (counters) {
+	  PerfCounters hardware;
+	  if (hardware.available()) {
+	    hardware.start();
+	    for (size_t i = 0; i != repetitions; i ++) {
+	      e.run(lhs, rhs, result);
+	    }
+	    perf = hardware.stop();
+	  }
+	}
+
+	write(json, first, e.name, distribution, size, e.threads(),
+	      Statistics(samples), ok, counters, perf);
+	first = false;
+      }
+    }
+  }
+  if (json) {
+    std::cout << (first ? "[\n]" : "\n]") << std::endl;
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,156 @@
+#include "Merge.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <random>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef int Type;
+
+/**
+ * Chronomètre merging::merge pour une politique d'exécution et compare son
+ * résultat à celui de l'algorithme merge de la bibliothèque standard.
+ *
+ * @param[in] name - le nom de la politique ;
+ * @param[in] policy - la politique d'exécution ;
+ * @param[in] lhs - le premier conteneur trié ;
+ * @param[in] rhs - le second conteneur trié ;
+ * @param[in] expected - le résultat attendu ;
+ * @param[in] seq - la durée d'exécution de l'algorithme merge ;
+ * @param[in] iters - le nombre de répétitions.
+ */
+template< typename Policy >
+void
+run(const std::string& name,
+    const Policy& policy,
+    const std::vector< Type >& lhs,
+    const std::vector< Type >& rhs,
+    const std::vector< Type >& expected,
+    const double& seq,
+    const size_t& iters) {
+
+  std::vector< Type > result(expected.size());
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    merging::merge(policy,
+		   lhs.begin(), lhs.end(),
+		   rhs.begin(), rhs.end(),
+		   result.begin());
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  const double par =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+
+  std::cout << "--[ merging::merge(" << name << "): begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << par << " msec." << std::endl;
+  std::cout << "\tVerdict:\t\t"
+	    << std::boolalpha
+	    << (iters == 0 || result == expected)
+	    << std::endl;
+  std::cout << "\tSpeedup:\t"
+	    << Metrics::speedup(seq, par)
+	    << std::endl;
+  std::cout << "--[ merging::merge: end ]--" << std::endl;
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0] << " nb_iterations nb_elements"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 : l'utilisateur fait n'importe
+  // quoi.
+  if (argc != 3) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations et du nombre d'éléments
+  // de chaque conteneur à fusionner.
+  size_t iters, size;
+  {
+    std::istringstream entree(argv[1]);
+    entree >> iters;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    std::istringstream entree(argv[2]);
+    entree >> size;
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Deux tableaux triés de valeurs aléatoires de tailles différentes.
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Type > distribution;
+  std::vector< Type > lhs(size), rhs(size + 211);
+  for (auto& x : lhs) {
+    x = distribution(generator);
+  }
+  for (auto& x : rhs) {
+    x = distribution(generator);
+  }
+  std::sort(lhs.begin(), lhs.end());
+  std::sort(rhs.begin(), rhs.end());
+
+  // Durée d'exécution de l'algorithme merge de la bibliothèque standard.
+  std::vector< Type > expected(lhs.size() + rhs.size());
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    std::merge(lhs.begin(), lhs.end(),
+	       rhs.begin(), rhs.end(),
+	       expected.begin());
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  const double seq =
+    std::chrono::duration< double, std::milli >(stop - start).count();
+  if (iters == 0) {
+    std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+	       expected.begin());
+  }
+
+  std::cout << "--[ merge: begin ]--" << std::endl;
+  std::cout << "\tDurée:\t\t" << seq << " msec." << std::endl;
+  std::cout << "--[ merge: end ]--" << std::endl;
+  std::cout << std::endl;
+
+  run("seq", merging::policy::seq, lhs, rhs, expected, seq, iters);
+  run("tbb_invoke", merging::policy::tbb_invoke, lhs, rhs, expected, seq,
+      iters);
+  run("tbb_tasks", merging::policy::tbb_tasks, lhs, rhs, expected, seq,
+      iters);
+  run("omp_corank", merging::policy::omp_corank, lhs, rhs, expected, seq,
+      iters);
+  run("automatic", merging::policy::automatic, lhs, rhs, expected, seq,
+      iters);
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
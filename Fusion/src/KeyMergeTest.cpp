@@ -0,0 +1,308 @@
+#include "ParallelRecursiveMerge.hpp"
+#include "Exercice5Test.hpp"
+#include "Metrics.hpp"
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <tbb/task_arena.h>
+#include <omp.h>
+
+/**
+ * Synonyme du type des clés.
+ */
+typedef std::int64_t Key;
+
+/**
+ * Synonyme du type des numéros d'enregistrements.
+ */
+typedef std::uint32_t Index;
+
+/**
+ * Un enregistrement : une clé et P octets de charge utile.
+ */
+template< size_t P >
+struct Record {
+  Key key;                                /** La clé. */
+  std::array< std::uint8_t, P > payload;  /** La charge utile. */
+};
+
+/**
+ * Deux sous-conteneurs d'enregistrements triés, rangés en tableau de
+ * structures (AoS) et en structure de tableaux (SoA).
+ */
+template< size_t P >
+struct Inputs {
+  std::vector< Record< P > > records1, records2;
+  std::vector< Key > keys1, keys2;
+  std::vector< std::array< std::uint8_t, P > > payloads1, payloads2;
+};
+
+/**
+ * Chronomètre iters exécutions d'une fonction.
+ *
+ * @param[in] iters - le nombre d'exécutions ;
+ * @param[in] f - la fonction à chronométrer.
+ * @return la durée totale en millisecondes.
+ */
+double
+timed(const size_t& iters, const std::function< void() >& f) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != iters; i ++) {
+    f();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration< double, std::milli >(stop - start).count();
+}
+
+/**
+ * Affiche les durées des fusions AoS et SoA d'un moteur.
+ *
+ * @param[in] name - le nom du moteur ;
+ * @param[in] aos - la durée de la fusion des enregistrements entiers ;
+ * @param[in] aosOk - son verdict ;
+ * @param[in] keys - la durée de la seule fusion par clé (permutation) ;
+ * @param[in] soa - la durée de la fusion par clé suivie du rassemblement ;
+ * @param[in] soaOk - son verdict.
+ */
+void
+report(const std::string& name, const double& aos, const bool& aosOk,
+       const double& keys, const double& soa, const bool& soaOk) {
+  std::cout << "--[ " << name << ": begin ]--" << std::endl;
+  std::cout << "\tAoS:\t\t" << aos << " msec.\t" << std::boolalpha << aosOk
+	    << std::endl;
+  std::cout << "\tClés seules:\t" << keys << " msec." << std::endl;
+  std::cout << "\tSoA:\t\t" << soa << " msec.\t" << std::boolalpha << soaOk
+	    << std::endl;
+  std::cout << "\tSpeedup:\t" << Metrics::speedup(aos, soa) << std::endl;
+  std::cout << "--[ " << name << ": end ]--" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * Compare, pour chaque moteur, la fusion des enregistrements entiers (AoS)
+ * à la fusion par clé suivie du rassemblement de la charge utile (SoA).
+ *
+ * @param[in] iters - le nombre de répétitions ;
+ * @param[in] size - le nombre d'enregistrements de chaque sous-conteneur.
+ */
+template< size_t P >
+void
+compare(const size_t& iters, const size_t& size) {
+
+  // Clés aléatoires (avec doublons), charge utile dérivée du numéro de
+  // l'enregistrement.
+  Inputs< P > in;
+  std::mt19937 generator(19);
+  std::uniform_int_distribution< Key > distribution(0, size);
+  for (auto* records : { &in.records1, &in.records2 }) {
+    records->resize(size);
+    for (size_t i = 0; i != size; i ++) {
+      (*records)[i].key = distribution(generator);
+    }
+    std::sort(records->begin(), records->end(),
+	      [](const Record< P >& a, const Record< P >& b) {
+		return a.key < b.key;
+	      });
+    const size_t shift = records == &in.records1 ? 0 : size;
+    for (size_t i = 0; i != size; i ++) {
+      (*records)[i].payload.fill(static_cast< std::uint8_t >(shift + i));
+      (*records)[i].payload[0] =
+	static_cast< std::uint8_t >((shift + i) >> 8);
+    }
+  }
+  for (const auto& r : in.records1) {
+    in.keys1.push_back(r.key);
+    in.payloads1.push_back(r.payload);
+  }
+  for (const auto& r : in.records2) {
+    in.keys2.push_back(r.key);
+    in.payloads2.push_back(r.payload);
+  }
+
+  // Référence : fusion stable séquentielle des enregistrements.
+  const auto less = [](const Record< P >& a, const Record< P >& b) {
+    return a.key < b.key;
+  };
+  const auto lessEqual = [](const Record< P >& a, const Record< P >& b) {
+    return a.key <= b.key;
+  };
+  std::vector< Record< P > > reference(2 * size);
+  std::merge(in.records1.begin(), in.records1.end(),
+	     in.records2.begin(), in.records2.end(),
+	     reference.begin(), less);
+
+  // Vérifications : AoS trié selon les mêmes clés, SoA identique à la
+  // référence (à clés égales, le premier sous-conteneur précède le second).
+  std::vector< Record< P > > records(2 * size);
+  std::vector< Key > keys(2 * size);
+  std::vector< Index > permutation(2 * size);
+  std::vector< std::array< std::uint8_t, P > > payloads(2 * size);
+  const auto checkAoS = [&]() {
+    for (size_t i = 0; i != records.size(); i ++) {
+      if (records[i].key != reference[i].key) {
+	return false;
+      }
+    }
+    return true;
+  };
+  const auto checkSoA = [&]() {
+    for (size_t i = 0; i != keys.size(); i ++) {
+      if (keys[i] != reference[i].key ||
+	  payloads[i] != reference[i].payload) {
+	return false;
+      }
+    }
+    return true;
+  };
+
+  std::cout << "Charge utile: " << P << " octets, enregistrements: "
+	    << sizeof(Record< P >) << " octets." << std::endl << std::endl;
+
+  // Moteur récursif (TBB).
+  {
+    const int threads = tbb::this_task_arena::max_concurrency();
+    const size_t cutoffAoS =
+      merging::CutoffCache::lookup(sizeof(Record< P >), threads);
+    const size_t cutoffSoA = merging::CutoffCache::lookup(sizeof(Key),
+							  threads);
+    const double aos = timed(iters, [&]() {
+	merging::ParallelRecursiveMerge::apply(in.records1.begin(),
+					       in.records1.end(),
+					       in.records2.begin(),
+					       in.records2.end(),
+					       records.begin(),
+					       less,
+					       cutoffAoS);
+      });
+    const bool aosOk = checkAoS();
+    const auto byKeyTBB = [&]() {
+	merging::ParallelRecursiveMerge::applyByKey(in.keys1.begin(),
+						    in.keys1.end(),
+						    in.keys2.begin(),
+						    in.keys2.end(),
+						    keys.begin(),
+						    permutation.begin(),
+						    std::less< const Key& >(),
+						    cutoffSoA);
+    };
+    const double byKey = timed(iters, byKeyTBB);
+    const double soa = timed(iters, [&]() {
+	byKeyTBB();
+	merging::ParallelRecursiveMerge::gather(permutation.begin(),
+						permutation.end(),
+						size,
+						in.payloads1.begin(),
+						in.payloads2.begin(),
+						payloads.begin(),
+						cutoffSoA);
+      });
+    report("ParallelRecursiveMerge", aos, aosOk, byKey, soa, checkSoA());
+  }
+
+  // Moteur par co-rangs (OpenMP).
+  {
+    const int threads = omp_get_max_threads();
+    const double aos = timed(iters, [&]() {
+	merging::ParallelStableMerge::apply(in.records1.begin(),
+					    in.records1.end(),
+					    in.records2.begin(),
+					    in.records2.end(),
+					    records.begin(),
+					    lessEqual,
+					    threads);
+      });
+    const bool aosOk = checkAoS();
+    std::fill(payloads.begin(), payloads.end(),
+	      std::array< std::uint8_t, P >());
+    const auto byKeyOMP = [&]() {
+	merging::ParallelStableMerge::applyByKey(in.keys1.begin(),
+						 in.keys1.end(),
+						 in.keys2.begin(),
+						 in.keys2.end(),
+						 keys.begin(),
+						 permutation.begin(),
+						 std::less_equal< const Key& >(),
+						 threads);
+    };
+    const double byKey = timed(iters, byKeyOMP);
+    const double soa = timed(iters, [&]() {
+	byKeyOMP();
+	merging::ParallelStableMerge::gather(permutation.begin(),
+					     permutation.end(),
+					     size,
+					     in.payloads1.begin(),
+					     in.payloads2.begin(),
+					     payloads.begin(),
+					     threads);
+      });
+    report("ParallelStableMerge", aos, aosOk, byKey, soa, checkSoA());
+  }
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0]
+	      << " nb_iterations nb_elements [taille_charge (32|64|128)]"
+	      << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 ou 3 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc != 3 && argc != 4) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations, du nombre
+  // d'enregistrements de chaque sous-conteneur et de la taille de la charge
+  // utile (64 octets par défaut).
+  size_t iters, size, payload = 64;
+  size_t* const parameters[] = { &iters, &size, &payload };
+  for (int a = 1; a != argc; a ++) {
+    std::istringstream entree(argv[a]);
+    entree >> *parameters[a - 1];
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  switch (payload) {
+  case 32:
+    compare< 32 >(iters, size);
+    break;
+  case 64:
+    compare< 64 >(iters, size);
+    break;
+  case 128:
+    compare< 128 >(iters, size);
+    break;
+  default:
+    std::cerr << "Taille de charge utile incorrecte." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,277 @@
+#include "Merge.hpp"
+#include "Metrics.hpp"
+#include "Pearson.hpp"
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include <omp.h>
+
+/**
+ * Synonyme du type des éléments à fusionner.
+ */
+typedef std::int32_t Type;
+
+/**
+ * Une charge de travail mesurée sous un nombre de threads imposé.
+ */
+struct Workload {
+  std::string name;                        /** Son nom. */
+  std::function< void(size_t) > prepare;   /** Construit ses entrées. */
+  std::function< void() > reference;       /** Sa version séquentielle. */
+  std::function< void() > run;             /** Sa version parallèle. */
+  std::function< bool() > check;           /** Son verdict. */
+};
+
+/**
+ * Chronomètre iters exécutions d'une fonction en limitant réellement la
+ * concurrence à threads : tbb::global_control borne le nombre de threads de
+ * TBB (y compris au-delà du nombre de cœurs), l'arène borne la concurrence
+ * vue par les moteurs TBB (this_task_arena::max_concurrency) et
+ * omp_set_num_threads l'équipe des régions parallèles OpenMP.
+ *
+ * @param[in] threads - le nombre de threads ;
+ * @param[in] iters - le nombre d'exécutions ;
+ * @param[in] f - la fonction à chronométrer.
+ * @return la durée totale en millisecondes.
+ */
+double
+timed(const int& threads, const size_t& iters,
+      const std::function< void() >& f) {
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+			      threads);
+  tbb::task_arena arena(threads);
+  omp_set_num_threads(threads);
+  const auto start = std::chrono::steady_clock::now();
+  arena.execute([&]() {
+      for (size_t i = 0; i != iters; i ++) {
+	f();
+      }
+    });
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration< double, std::milli >(stop - start).count();
+}
+
+/**
+ * Fabrique une charge de travail reposant sur merging::merge. La référence
+ * séquentielle est le meilleur algorithme séquentiel disponible, la
+ * politique seq (MergeKernel).
+ *
+ * @param[in] name - le nom du moteur ;
+ * @param[in] policy - la politique d'exécution.
+ * @return la charge de travail.
+ */
+template< typename Policy >
+Workload
+mergeWorkload(const std::string& name, const Policy& policy) {
+  struct Data {
+    std::vector< Type > lhs, rhs, result;
+  };
+  const auto data = std::make_shared< Data >();
+  return Workload {
+    name,
+    [data](size_t size) {
+      std::mt19937 generator(19);
+      std::uniform_int_distribution< Type > distribution;
+      data->lhs.resize(size / 2);
+      data->rhs.resize(size - size / 2);
+      for (auto& x : data->lhs) {
+	x = distribution(generator);
+      }
+      for (auto& x : data->rhs) {
+	x = distribution(generator);
+      }
+      std::sort(data->lhs.begin(), data->lhs.end());
+      std::sort(data->rhs.begin(), data->rhs.end());
+      data->result.assign(size, 0);
+    },
+    [data]() {
+      merging::merge(merging::policy::seq,
+		     data->lhs.begin(), data->lhs.end(),
+		     data->rhs.begin(), data->rhs.end(),
+		     data->result.begin());
+    },
+    [data, policy]() {
+      merging::merge(policy,
+		     data->lhs.begin(), data->lhs.end(),
+		     data->rhs.begin(), data->rhs.end(),
+		     data->result.begin());
+    },
+    [data]() {
+      return std::is_sorted(data->result.begin(), data->result.end());
+    } };
+}
+
+/**
+ * Fabrique la charge de travail de l'Exercice4 : la corrélation de Pearson
+ * par tbb::parallel_reduce. La référence séquentielle est le même calcul
+ * limité à un thread.
+ *
+ * @return la charge de travail.
+ */
+Workload
+pearsonWorkload() {
+  struct Data {
+    std::vector< double > x, y;
+    Correlation result;
+  };
+  const auto data = std::make_shared< Data >();
+  return Workload {
+    "pearson",
+    [data](size_t size) {
+      std::mt19937 generator(19);
+      std::normal_distribution< double > noise;
+      data->x.resize(size);
+      data->y.resize(size);
+      for (size_t i = 0; i != size; i ++) {
+	data->x[i] = i;
+	data->y[i] = 2.0 * i + 1.0 + noise(generator);
+      }
+    },
+    [data]() {
+      const Data_Set set = { data->x.size(), data->x.data(), data->y.data() };
+      tbb::task_arena serial(1);
+      serial.execute([&]() {
+	  data->result = calculate(set);
+	});
+    },
+    [data]() {
+      const Data_Set set = { data->x.size(), data->x.data(), data->y.data() };
+      data->result = calculate(set);
+    },
+    [data]() {
+      return std::fabs(data->result.a - 2.0) < 1e-3;
+    } };
+}
+
+/**
+ * Mesure une charge de travail de 1 à maxThreads threads et affiche le
+ * tableau des résultats puis les lois d'échelle ajustées.
+ *
+ * @param[in] weak - vrai pour le weak scaling (size éléments par thread),
+ *   faux pour le strong scaling (size éléments en tout) ;
+ * @param[in] workload - la charge de travail ;
+ * @param[in] size - le nombre d'éléments (par thread en weak scaling) ;
+ * @param[in] maxThreads - le plus grand nombre de threads ;
+ * @param[in] iters - le nombre de répétitions.
+ *
+ * @note L'accélération est rapportée à la référence séquentielle mesurée à
+ *   la même taille : en weak scaling, c'est l'accélération à taille
+ *   croissante de Gustafson et l'efficacité idéale reste 1.
+ */
+void
+scale(const bool& weak, Workload& workload, const size_t& size,
+      const int& maxThreads, const size_t& iters) {
+
+  const std::string mode = weak ? "Weak scaling" : "Strong scaling";
+  std::cout << "--[ " << mode << ": " << workload.name << ": begin ]--"
+	    << std::endl;
+  std::cout << "\tThread(s)\tTaille\t\tDurée\t\tSpeedup\t\tEfficiency"
+	    << "\tVerdict" << std::endl;
+
+  // Durées parallèles normalisées par la référence séquentielle.
+  std::vector< unsigned > procs;
+  std::vector< double > pars;
+  for (int nb = 1; nb <= maxThreads; nb ++) {
+    const size_t n = weak ? size * nb : size;
+    workload.prepare(n);
+    const double seq = timed(1, iters, workload.reference);
+    const double par = timed(nb, iters, workload.run);
+    const bool ok = workload.check();
+    procs.push_back(nb);
+    pars.push_back(par / seq);
+    std::cout << '\t' << nb
+	      << "\t\t" << n
+	      << "\t\t" << par << " msec."
+	      << '\t' << Metrics::speedup(seq, par)
+	      << "\t\t" << Metrics::efficiency(seq, par, nb)
+	      << "\t\t" << std::boolalpha << ok
+	      << std::endl;
+  }
+  std::cout << "--[ " << mode << ": end ]--" << std::endl;
+
+  // Lois d'échelle : Amdahl pour le strong scaling, Gustafson pour le weak
+  // scaling.
+  Metrics::report(std::cout, Metrics::scaling(1, procs, pars));
+  std::cout << std::endl;
+
+}
+
+/**
+ * Programme principal.
+ *
+ * @param[in] argc le nombre d'arguments de la ligne de commandes.
+ * @param[in] argv les arguments de la ligne de commandes.
+ * @return @c EXIT_SUCCESS en cas d'exécution réussie ou @c EXIT_FAILURE en cas
+ *   de problèmes.
+ */
+int
+main(int argc, char* argv[]) {
+
+  // La ligne de commandes est vide : l'utilisateur demande de l'aide.
+  if (argc == 1) {
+    std::cout << "Usage: " << argv[0]
+	      << " nb_iterations nb_elements [nb_threads_max]" << std::endl;
+    std::cout << "\tStrong scaling : nb_elements en tout ; weak scaling :"
+	      << " nb_elements par thread. Par défaut, nb_threads_max est le"
+	      << " nombre de cœurs logiques." << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // Le nombre d'arguments est différent de 2 ou 3 : l'utilisateur fait
+  // n'importe quoi.
+  if (argc != 3 && argc != 4) {
+    std::cerr << "Nombre d'argument(s) incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Tentative d'extraction du nombre d'itérations, du nombre d'éléments et
+  // du nombre de threads maximal.
+  size_t values[3] = { 0, 0,
+		       static_cast< size_t >(tbb::this_task_arena::max_concurrency()) };
+  for (int a = 1; a != argc; a ++) {
+    std::istringstream entree(argv[a]);
+    entree >> values[a - 1];
+    if (! entree || ! entree.eof()) {
+      std::cerr << "Argument incorrect." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  const size_t iters = values[0];
+  const size_t size = values[1];
+  const int maxThreads = static_cast< int >(values[2]);
+  if (iters == 0 || size < 2 || maxThreads < 1) {
+    std::cerr << "Argument incorrect." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Les charges de travail mesurées.
+  std::vector< Workload > workloads = {
+    mergeWorkload("seq", merging::policy::seq),
+    mergeWorkload("tbb_invoke", merging::policy::tbb_invoke),
+    mergeWorkload("tbb_tasks", merging::policy::tbb_tasks),
+    mergeWorkload("omp_corank", merging::policy::omp_corank),
+    mergeWorkload("automatic", merging::policy::automatic),
+    pearsonWorkload()
+  };
+
+  for (const bool weak : { false, true }) {
+    for (Workload& workload : workloads) {
+      scale(weak, workload, size, maxThreads, iters);
+    }
+  }
+
+  // Tout s'est bien passé.
+  return EXIT_SUCCESS;
+
+}
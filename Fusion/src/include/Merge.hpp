@@ -0,0 +1,280 @@
+#ifndef Merge_hpp
+#define Merge_hpp
+
+#include "ParallelRecursiveMerge.hpp"
+#include "Exercice5Test.hpp"
+#include "MergeKernel.hpp"
+#include "CutoffCache.hpp"
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <tbb/tbb.h>
+#include <omp.h>
+
+namespace merging {
+
+  /**
+   * Politiques d'exécution de merging::merge. Chaque politique est un type
+   * distinct : le moteur est choisi à la compilation par surcharge, sauf pour
+   * automatic qui le choisit à l'exécution.
+   */
+  namespace policy {
+
+    /** Fusion séquentielle (MergeKernel). */
+    struct seq_t {};
+
+    /** ParallelRecursiveMerge, récursion via tbb::parallel_invoke. */
+    struct tbb_invoke_t {};
+
+    /** ParallelRecursiveMerge, récursion via tbb::task_group. */
+    struct tbb_tasks_t {};
+
+    /** ParallelStableMerge, partitionnement par co-rang et OpenMP. */
+    struct omp_corank_t {};
+
+    /** Choix du moteur d'après la taille des entrées et les threads. */
+    struct auto_t {};
+
+    constexpr seq_t seq {};
+    constexpr tbb_invoke_t tbb_invoke {};
+    constexpr tbb_tasks_t tbb_tasks {};
+    constexpr omp_corank_t omp_corank {};
+
+    /** auto étant un mot-clé, la politique automatique se nomme automatic. */
+    constexpr auto_t automatic {};
+
+  } // policy
+
+  /**
+   * Fusion séquentielle.
+   *
+   * @param[in] policy - la politique d'exécution ;
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou récopier le
+   *   premier élément résultant de la fusion ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   total (strict, comme pour std::merge) régissant les sous-conteneurs.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  OutputRandomAccessIterator
+  merge(policy::seq_t,
+	const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    return MergeKernel::apply(first1, last1, first2, last2, result, comp);
+  }
+
+  /**
+   * Fusion via ParallelRecursiveMerge et tbb::parallel_invoke, avec la
+   * tolérance calibrée sur la machine courante (voir CutoffCache).
+   *
+   * @param[in] policy - la politique d'exécution ;
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou récopier le
+   *   premier élément résultant de la fusion ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   total (strict) régissant les sous-conteneurs.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  OutputRandomAccessIterator
+  merge(policy::tbb_invoke_t,
+	const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    typedef typename std::iterator_traits< InputRandomAccessIterator1 >
+      ::value_type value_type;
+    const size_t cutoff =
+      CutoffCache::lookup(sizeof(value_type),
+			  tbb::this_task_arena::max_concurrency());
+    return ParallelRecursiveMerge::applyInvoke(first1, last1, first2, last2,
+					       result, comp, cutoff);
+  }
+
+  /**
+   * Fusion via ParallelRecursiveMerge et tbb::task_group, avec la tolérance
+   * calibrée sur la machine courante (voir CutoffCache).
+   *
+   * @param[in] policy - la politique d'exécution ;
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou récopier le
+   *   premier élément résultant de la fusion ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   total (strict) régissant les sous-conteneurs.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  OutputRandomAccessIterator
+  merge(policy::tbb_tasks_t,
+	const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    return ParallelRecursiveMerge::apply(first1, last1, first2, last2,
+					 result, comp);
+  }
+
+  /**
+   * Fusion via ParallelStableMerge avec tous les threads OpenMP disponibles.
+   *
+   * @param[in] policy - la politique d'exécution ;
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou récopier le
+   *   premier élément résultant de la fusion ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   total (strict) régissant les sous-conteneurs.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  OutputRandomAccessIterator
+  merge(policy::omp_corank_t,
+	const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    return ParallelStableMerge::apply(first1, last1, first2, last2, result,
+				      ParallelStableMerge::strict(comp),
+				      omp_get_max_threads());
+  }
+
+  /**
+   * Fusion par le moteur le plus adapté : la fusion séquentielle lorsqu'un
+   * seul thread est disponible ou que les entrées tiennent dans deux feuilles
+   * de la tolérance calibrée, ParallelRecursiveMerge (tbb::task_group) sinon.
+   * ParallelStableMerge n'est jamais choisi : son équipe de threads OpenMP
+   * s'ajouterait à ceux de TBB déjà actifs chez l'appelant.
+   *
+   * @param[in] policy - la politique d'exécution ;
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou récopier le
+   *   premier élément résultant de la fusion ;
+   * @param[in] comp - un comparateur binaire représentant la relation d'ordre
+   *   total (strict) régissant les sous-conteneurs.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator,
+	    typename Compare >
+  OutputRandomAccessIterator
+  merge(policy::auto_t,
+	const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result,
+	const Compare& comp) {
+    typedef typename std::iterator_traits< InputRandomAccessIterator1 >
+      ::value_type value_type;
+    const int threads = tbb::this_task_arena::max_concurrency();
+    const size_t cutoff = CutoffCache::lookup(sizeof(value_type), threads);
+    const size_t size = (last1 - first1) + (last2 - first2);
+    if (threads == 1 || size < 2 * cutoff) {
+      return merging::merge(policy::seq, first1, last1, first2, last2, result,
+			    comp);
+    }
+    return ParallelRecursiveMerge::apply(first1, last1, first2, last2,
+					 result, comp, cutoff);
+  }
+
+  /**
+   * Forme spécifique de merging::merge pour la relation d'ordre total
+   * strictement inférieur à.
+   *
+   * @param[in] policy - la politique d'exécution ;
+   * @param[in] first1 - un itérateur repérant le premier élément du premier
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last1 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du premier sous-conteneur concerné par la fusion ;
+   * @param[in] first2 - un itérateur repérant le premier élément du second
+   *   sous-conteneur concerné par la fusion ;
+   * @param[in] last2 - un itérateur repérant l'élément situé juste derrière
+   *   le dernier élément du second sous-conteneur concerné par la fusion ;
+   * @param[in] result - un itérateur repérant la position ou récopier le
+   *   premier élément résultant de la fusion.
+   * @return un itérateur repérant la fin de la zone de fusion dans le
+   *   conteneur cible.
+   */
+  template< typename Policy,
+	    typename InputRandomAccessIterator1,
+	    typename InputRandomAccessIterator2,
+	    typename OutputRandomAccessIterator >
+  OutputRandomAccessIterator
+  merge(const Policy& policy,
+	const InputRandomAccessIterator1& first1,
+	const InputRandomAccessIterator1& last1,
+	const InputRandomAccessIterator2& first2,
+	const InputRandomAccessIterator2& last2,
+	const OutputRandomAccessIterator& result) {
+    typedef typename std::iterator_traits< InputRandomAccessIterator1 >
+      ::value_type value_type;
+    return merging::merge(policy, first1, last1, first2, last2, result,
+			  std::less< const value_type& >());
+  }
+
+} // merging
+
+#endif
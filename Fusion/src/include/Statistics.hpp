@@ -0,0 +1,117 @@
+#ifndef Statistics_hpp
+#define Statistics_hpp
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+/**
+ * @class Statistics Statistics.hpp
+ *
+ * Résumé statistique d'une série de mesures (durées d'exécution en
+ * nanosecondes, par exemple).
+ */
+class Statistics {
+public:
+
+  /**
+   * Constructeur : la série est copiée puis triée.
+   *
+   * @param[in] samples - les mesures.
+   */
+  explicit Statistics(const std::vector< double >& samples)
+    : sorted(samples) {
+    std::sort(sorted.begin(), sorted.end());
+  }
+
+  /**
+   * Retourne le quantile d'ordre q, interpolé linéairement entre les deux
+   * mesures qui l'encadrent.
+   *
+   * @param[in] q - l'ordre du quantile, entre 0 et 1.
+   * @return le quantile ou 0 si la série est vide.
+   */
+  double quantile(const double& q) const {
+    if (sorted.empty()) {
+      return 0;
+    }
+    const double position = q * (sorted.size() - 1);
+    const size_t low = static_cast< size_t >(std::floor(position));
+    const size_t high = std::min(low + 1, sorted.size() - 1);
+    const double weight = position - low;
+    return sorted[low] * (1 - weight) + sorted[high] * weight;
+  }
+
+  /**
+   * Retourne la médiane.
+   *
+   * @return la médiane.
+   */
+  double median() const {
+    return quantile(0.5);
+  }
+
+  /**
+   * Retourne la plus petite mesure.
+   *
+   * @return le minimum ou 0 si la série est vide.
+   */
+  double min() const {
+    return sorted.empty() ? 0 : sorted.front();
+  }
+
+  /**
+   * Retourne la plus grande mesure.
+   *
+   * @return le maximum ou 0 si la série est vide.
+   */
+  double max() const {
+    return sorted.empty() ? 0 : sorted.back();
+  }
+
+  /**
+   * Retourne la moyenne.
+   *
+   * @return la moyenne ou 0 si la série est vide.
+   */
+  double mean() const {
+    if (sorted.empty()) {
+      return 0;
+    }
+    return std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+  }
+
+  /**
+   * Retourne l'écart-type (estimateur non biaisé).
+   *
+   * @return l'écart-type ou 0 si la série compte moins de deux mesures.
+   */
+  double stddev() const {
+    if (sorted.size() < 2) {
+      return 0;
+    }
+    const double m = mean();
+    double sum = 0;
+    for (const double x : sorted) {
+      sum += (x - m) * (x - m);
+    }
+    return std::sqrt(sum / (sorted.size() - 1));
+  }
+
+  /**
+   * Retourne le nombre de mesures.
+   *
+   * @return le nombre de mesures.
+   */
+  size_t count() const {
+    return sorted.size();
+  }
+
+private:
+
+  std::vector< double > sorted;   /** Les mesures triées. */
+
+}; // Statistics
+
+#endif